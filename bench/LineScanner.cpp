@@ -0,0 +1,353 @@
+/**
+ *  @file   LineScanner.cpp
+ *  @brief  /proc Row Lookup Benchmark
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+#include <chrono>
+
+#include <fstream>
+
+#include <functional>
+
+#include <string>
+
+#include <vector>
+
+#include "LineScanner.h"
+#include "ProcFile.h"
+
+static const int ITERATIONS = 2000;
+
+// a /proc/net/dev with n interfaces, the last one being the one looked up
+static std::string net_dev(int n) {
+
+  std::string table = "Inter-|   Receive                            "
+                      "                    |  Transmit\n"
+                      " face |bytes    packets errs drop fifo frame "
+                      "compressed multicast|bytes    packets errs drop "
+                      "fifo colls carrier compressed\n";
+
+  char row[256];
+
+  for (int i = 0; i < n; i++) {
+
+    snprintf(row, sizeof(row),
+             "%6s%d: %llu %d 0 0 0 0 0 0 %llu %d 0 0 0 0 0 0\n",
+             i == n - 1 ? "eth" : "veth", i, 1000003ULL * i, i, 999983ULL * i,
+             i);
+
+    table += row;
+  }
+
+  return table;
+}
+
+// a /proc/diskstats with n devices
+static std::string diskstats(int n) {
+
+  std::string table;
+
+  char row[256];
+
+  for (int i = 0; i < n; i++) {
+
+    snprintf(row, sizeof(row),
+             "%4d %7d nvme%dn1 %d 0 %llu %d %d 0 %llu %d 0 %d %d 0 0 0 0\n",
+             259, i, i, 7 * i, 1000003ULL * i, 3 * i, 5 * i, 999983ULL * i,
+             11 * i, 13 * i, 17 * i);
+
+    table += row;
+  }
+
+  return table;
+}
+
+// Writes table to path, to be read back as a /proc file would be.
+static int write_table(const std::string &path, const std::string &table) {
+
+  FILE *file = fopen(path.c_str(), "w");
+
+  if (file == nullptr) {
+
+    return 1;
+  }
+
+  size_t written = fwrite(table.data(), 1, table.size(), file);
+
+  return fclose(file) != 0 || written != table.size() ? 1 : 0;
+}
+
+// Reports the megabytes of a size byte table that lookup gets through per
+// second.
+static double rate(size_t size,
+                   const std::function<unsigned long long()> &lookup,
+                   unsigned long long &checksum) {
+
+  checksum = 0;
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  for (int n = 0; n < ITERATIONS; n++) {
+
+    checksum += lookup();
+  }
+
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  return 1e-6 * size * ITERATIONS / elapsed;
+}
+
+// Reads the net/dev table at path and looks up name the way ProcManager
+// does, and as it did with std::getline() and sscanf(3); the lookup must
+// match the old one and outpace it.
+static int bench_net_dev(const char *label, const std::string &path,
+                         const std::string &name) {
+
+  ProcFile file;
+
+  if (file.Open(path.c_str(), O_RDONLY, ProcFile::Layout::Table) != 0 ||
+      file.Read() != 0) {
+
+    return 0;
+  }
+
+  unsigned long long scanned, reference;
+
+  double fast = rate(
+      file.Size(),
+      [&]() {
+        const char *fields[10];
+
+        size_t lengths[10];
+
+        if (file.Read() != 0) {
+
+          return 0ULL;
+        }
+
+        LineScanner scanner(file.Data(), file.Size(), ':');
+
+        return scanner.FindLine(name.data(), name.size(), 0) &&
+                       scanner.Fields(fields, lengths, 10) == 10
+                   ? LineScanner::Decimal(fields[1], lengths[1]) +
+                         LineScanner::Decimal(fields[9], lengths[9])
+                   : 0ULL;
+      },
+      scanned);
+
+  double slow = rate(
+      file.Size(),
+      [&]() {
+        std::ifstream fstream(path, std::ios::in);
+
+        std::string line;
+
+        unsigned long received = 0, sent = 0;
+
+        while (std::getline(fstream, line)) {
+
+          size_t at = line.find(name + ':');
+
+          if (at != std::string::npos && (at == 0 || line[at - 1] == ' ')) {
+
+            sscanf(line.c_str(), " %*s %lu %*d %*d %*d %*d %*d %*d %*d %lu",
+                   &received, &sent);
+
+            break;
+          }
+        }
+
+        return static_cast<unsigned long long>(received + sent);
+      },
+      reference);
+
+  printf("LineScanner: %-24s %8.1f MB/s, getline+sscanf %8.1f MB/s%s%s\n",
+         label, fast, slow, scanned == reference ? "" : " (MISMATCH)",
+         fast >= slow ? "" : " (SLOWER)");
+
+  return scanned == reference && fast >= slow ? 0 : 1;
+}
+
+// Reads the diskstats table at path and looks up every fourth device in
+// the order of the table, the way BlockDevices does, and as ProcManager
+// did with std::getline() and sscanf(3), which it must match and outpace.
+static int bench_diskstats(const char *label, const std::string &path) {
+
+  ProcFile file;
+
+  if (file.Open(path.c_str(), O_RDONLY, ProcFile::Layout::Table) != 0 ||
+      file.Read() != 0) {
+
+    return 0;
+  }
+
+  std::vector<std::string> names;
+
+  LineScanner lines(file.Data(), file.Size());
+
+  const char *fields[14];
+
+  size_t lengths[14];
+
+  for (int row = 0; lines.NextLine(); row++) {
+
+    if (row % 4 == 0 && lines.Fields(fields, lengths, 3) == 3) {
+
+      names.push_back(std::string(fields[2], lengths[2]));
+    }
+  }
+
+  unsigned long long scanned, reference;
+
+  double fast = rate(
+      file.Size(),
+      [&]() {
+        unsigned long long sum = 0;
+
+        if (file.Read() != 0) {
+
+          return sum;
+        }
+
+        LineScanner scanner(file.Data(), file.Size());
+
+        for (const std::string &name : names) {
+
+          if (scanner.FindLine(name.data(), name.size(), 2) &&
+              scanner.Fields(fields, lengths, 14) == 14) {
+
+            sum += LineScanner::Decimal(fields[5], lengths[5]) +
+                   LineScanner::Decimal(fields[9], lengths[9]);
+          }
+        }
+
+        return sum;
+      },
+      scanned);
+
+  double slow = rate(
+      file.Size(),
+      [&]() {
+        unsigned long long sum = 0;
+
+        std::ifstream fstream(path, std::ios::in);
+
+        std::string line;
+
+        for (size_t next = 0;
+             next < names.size() && std::getline(fstream, line);) {
+
+          if (line.find(' ' + names[next] + ' ') == std::string::npos) {
+
+            continue;
+          }
+
+          unsigned long read = 0, written = 0;
+
+          if (sscanf(line.c_str(), "%*d %*d %*s %*d %*d %lu %*d %*d %*d %lu",
+                     &read, &written) == 2) {
+
+            sum += read + written;
+          }
+
+          ++next;
+        }
+
+        return sum;
+      },
+      reference);
+
+  printf("LineScanner: %-24s %8.1f MB/s, getline+sscanf %8.1f MB/s%s%s\n",
+         label, fast, slow, scanned == reference ? "" : " (MISMATCH)",
+         fast >= slow ? "" : " (SLOWER)");
+
+  return scanned == reference && fast >= slow ? 0 : 1;
+}
+
+// Returns the name of the last interface of the net/dev table at path,
+// the one that takes longest to find.
+static std::string last_interface(const std::string &path) {
+
+  ProcFile file;
+
+  std::string name;
+
+  if (file.Open(path.c_str(), O_RDONLY, ProcFile::Layout::Table) != 0 ||
+      file.Read() != 0) {
+
+    return name;
+  }
+
+  LineScanner scanner(file.Data(), file.Size(), ':');
+
+  const char *fields[1];
+
+  size_t lengths[1];
+
+  while (scanner.NextLine()) {
+
+    if (scanner.Fields(fields, lengths, 1) == 1) {
+
+      name.assign(fields[0], lengths[0]);
+    }
+  }
+
+  return name;
+}
+
+int main(int argc, char *argv[]) {
+
+  std::string root = argc > 1 ? argv[1] : "/proc";
+
+  char directory[] = "/tmp/bPulse.XXXXXX";
+
+  if (mkdtemp(directory) == nullptr) {
+
+    perror("LineScanner");
+
+    return 1;
+  }
+
+  std::string net_dev_path = std::string(directory) + "/net_dev",
+              diskstats_path = std::string(directory) + "/diskstats";
+
+  int error = write_table(net_dev_path, net_dev(4000)) |
+              write_table(diskstats_path, diskstats(2000));
+
+  if (error == 0) {
+
+    error |=
+        bench_net_dev("net/dev, 4000 interfaces", net_dev_path, "eth3999") |
+        bench_diskstats("diskstats, 2000 devices", diskstats_path);
+  }
+
+  unlink(net_dev_path.c_str());
+
+  unlink(diskstats_path.c_str());
+
+  rmdir(directory);
+
+  std::string name = last_interface(root + "/net/dev");
+
+  if (!name.empty()) {
+
+    error |= bench_net_dev((root + "/net/dev").c_str(), root + "/net/dev",
+                           name);
+  }
+
+  return error | bench_diskstats((root + "/diskstats").c_str(),
+                                 root + "/diskstats");
+}
@@ -0,0 +1,163 @@
+/**
+ *  @file   ProcStat.cpp
+ *  @brief  /proc/stat Parser Benchmark
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <sstream>
+
+#include <string>
+
+#include "ProcFile.h"
+#include "ProcManager.h"
+
+static const int ITERATIONS = 20000;
+
+// a /proc/stat of a machine with n CPUs
+static std::string proc_stat(int n) {
+
+  std::string table;
+
+  char row[256];
+
+  // the aggregate line leads, with two blanks after its label
+  for (int i = -1; i < n; i++) {
+
+    unsigned long scale = i < 0 ? n : 1;
+
+    snprintf(row, sizeof(row), "%s %lu %lu %lu %lu %lu %lu %lu 0 0 0\n",
+             i < 0 ? "cpu " : ("cpu" + std::to_string(i)).c_str(),
+             scale * (1000003UL + 17UL * i), scale * (2003UL + i),
+             scale * (500009UL + 13UL * i), scale * (9000011UL + 7UL * i),
+             scale * (3001UL + i), scale * (101UL + i), scale * (307UL + i));
+
+    table += row;
+  }
+
+  table += "intr 123456789 0 9 0 0\nctxt 987654321\nbtime 1700000000\n"
+           "processes 4321\nprocs_running 2\nprocs_blocked 0\n"
+           "softirq 1234 0 1 2 3 4 5 6 7 8 9\n";
+
+  return table;
+}
+
+// Parses a /proc/stat the way a probe does, for the line of label and the
+// busy and total time of every core, with ProcManager's single pass and
+// with getline(3) and sscanf(3) as it used to, and checks that both read
+// the same counters.
+class ProcStatBench {
+
+public:
+  static int Run(const char *name, const std::string &table,
+                 const char *label);
+};
+
+int ProcStatBench::Run(const char *name, const std::string &table,
+                       const char *label) {
+
+  struct ProcManager::s_pcpu parsed = {}, scanned = {};
+
+  struct ProcManager::s_pcores cores, reference;
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  for (int n = 0; n < ITERATIONS; n++) {
+
+    ProcManager::_parse_stat(table.c_str(), label, &parsed, &cores);
+  }
+
+  std::chrono::steady_clock::time_point middle =
+      std::chrono::steady_clock::now();
+
+  for (int n = 0; n < ITERATIONS; n++) {
+
+    std::istringstream stream(table);
+
+    std::string line;
+
+    while (std::getline(stream, line) && line.compare(0, 3, "cpu") == 0) {
+
+      struct ProcManager::s_pcpu cpu = {};
+
+      size_t core;
+
+      sscanf(line.c_str(), "%*s %lu %lu %lu %lu %lu %lu %lu %lu", &cpu.user,
+             &cpu.nice, &cpu.sys, &cpu.idle, &cpu.iowait, &cpu.irq,
+             &cpu.softirq, &cpu.steal);
+
+      cpu.total = cpu.user + cpu.nice + cpu.sys + cpu.idle + cpu.iowait +
+                  cpu.irq + cpu.softirq + cpu.steal;
+
+      if (line.compare(0, line.find(' '), label) == 0) {
+
+        scanned = cpu;
+      }
+
+      if (isdigit(line[3]) && sscanf(line.c_str(), "cpu%zu", &core) == 1) {
+
+        reference.busy.resize(std::max(reference.busy.size(), core + 1));
+
+        reference.total.resize(reference.busy.size());
+
+        reference.busy[core] = cpu.total - cpu.idle - cpu.iowait;
+
+        reference.total[core] = cpu.total;
+      }
+    }
+  }
+
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  double fast = std::chrono::duration<double, std::micro>(middle - start)
+                    .count() /
+                ITERATIONS,
+         slow = std::chrono::duration<double, std::micro>(end - middle)
+                    .count() /
+                ITERATIONS;
+
+  bool match = parsed.total == scanned.total && parsed.user == scanned.user &&
+               parsed.idle == scanned.idle && parsed.steal == scanned.steal &&
+               cores.busy == reference.busy && cores.total == reference.total;
+
+  printf("ProcStat: %-16s %-7s parser %6.2f us, getline+sscanf %6.2f us "
+         "per read%s\n",
+         name, label, fast, slow, match ? "" : " (MISMATCH)");
+
+  return match ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+
+  std::string root = argc > 1 ? argv[1] : "/proc";
+
+  std::string synthetic = proc_stat(256);
+
+  int error = 0;
+
+  for (const char *label : {"cpu", "cpu255"}) {
+
+    error |= ProcStatBench::Run("stat, 256 CPUs", synthetic, label);
+  }
+
+  ProcFile file;
+
+  if (file.Open((root + "/stat").c_str()) == 0 && file.Read() == 0) {
+
+    error |= ProcStatBench::Run((root + "/stat").c_str(),
+                                std::string(file.Data(), file.Size()), "cpu");
+  }
+
+  return error;
+}
@@ -0,0 +1,228 @@
+/**
+ *  @file   ProcessSampler.cpp
+ *  @brief  Top Process Sampler Benchmark
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <string>
+
+#include <vector>
+
+#include "ProcessSampler.h"
+
+static const int PROCESSES = 20000;
+
+static const int SAMPLES = 32;
+
+static const int RESCANS = 4;
+
+// the processes that keep the CPU busy, the later ones the busier
+static const pid_t BUSY[] = {1000, 5000, 12000, 19000};
+
+static double cpu_time() {
+
+  struct timespec now;
+
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+  return 1e6 * now.tv_sec + 1e-3 * now.tv_nsec;
+}
+
+// Writes the stat of pid under root as it stands after ticks of CPU time.
+static int write_stat(const std::string &root, pid_t pid,
+                      unsigned long long ticks) {
+
+  std::string directory = root + '/' + std::to_string(pid);
+
+  mkdir(directory.c_str(), 0755);
+
+  FILE *file = fopen((directory + "/stat").c_str(), "w");
+
+  if (file == nullptr) {
+
+    return 1;
+  }
+
+  fprintf(file,
+          "%d (task %d) R 1 %d %d 0 -1 4194304 0 0 0 0 %llu 0 0 0 20 0 1 0 "
+          "%d 12345678 250 0\n",
+          pid, pid, pid, pid, ticks, 10 * pid);
+
+  fclose(file);
+
+  return 0;
+}
+
+// Reads the stat of every process under root, as a full rescan would, and
+// reports the CPU time it took in microseconds.
+static double rescan(const std::string &root) {
+
+  double start = cpu_time();
+
+  DIR *dir = opendir(root.c_str());
+
+  if (dir == nullptr) {
+
+    return 0.0;
+  }
+
+  char buffer[1024];
+
+  struct dirent *entry;
+
+  while ((entry = readdir(dir)) != nullptr) {
+
+    if (entry->d_name[0] < '1' || entry->d_name[0] > '9') {
+
+      continue;
+    }
+
+    int fd = open((root + '/' + entry->d_name + "/stat").c_str(),
+                  O_RDONLY | O_CLOEXEC);
+
+    if (fd >= 0) {
+
+      if (read(fd, buffer, sizeof(buffer)) < 0) {
+
+        buffer[0] = '\0';
+      }
+
+      close(fd);
+    }
+  }
+
+  closedir(dir);
+
+  return cpu_time() - start;
+}
+
+// Samples root SAMPLES times, calling tick before each, and reports the
+// mean and worst CPU time of a Sample() next to the mean of RESCANS full
+// rescans; a Sample() that is slower on average than a rescan fails.
+template <typename Tick>
+static int bench(const char *label, const std::string &root, Tick tick,
+                 std::vector<struct ProcessSampler::s_process> &processes) {
+
+  ProcessSampler sampler(root.c_str());
+
+  double total = 0.0, worst = 0.0;
+
+  for (int n = 0; n < SAMPLES; n++) {
+
+    tick(n);
+
+    double start = cpu_time();
+
+    sampler.Sample(processes);
+
+    double elapsed = cpu_time() - start;
+
+    total += elapsed;
+
+    worst = std::max(worst, elapsed);
+  }
+
+  double full = 0.0;
+
+  for (int n = 0; n < RESCANS; n++) {
+
+    full += rescan(root);
+  }
+
+  full /= RESCANS;
+
+  printf("ProcessSampler: %-22s Sample() %7.0f us mean, %7.0f us worst, "
+         "full rescan %7.0f us\n",
+         label, total / SAMPLES, worst, full);
+
+  if (total / SAMPLES > full) {
+
+    printf("ProcessSampler: %s Sample() is slower than a full rescan\n",
+           label);
+
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+
+  std::string root = argc > 1 ? argv[1] : "/proc";
+
+  char directory[] = "/tmp/bPulse.XXXXXX";
+
+  if (mkdtemp(directory) == nullptr) {
+
+    perror("ProcessSampler");
+
+    return 1;
+  }
+
+  std::string synthetic(directory);
+
+  int error = 0;
+
+  for (pid_t pid = 1; pid <= PROCESSES && error == 0; pid++) {
+
+    error |= write_stat(synthetic, pid, 0);
+  }
+
+  std::vector<struct ProcessSampler::s_process> top;
+
+  if (error == 0) {
+
+    error |= bench(
+        "20000 processes", synthetic,
+        [&](int n) {
+          for (pid_t pid : BUSY) {
+
+            write_stat(synthetic, pid, 1ULL * n * pid / 100);
+          }
+        },
+        top);
+  }
+
+  // the three busiest come out on top, the busiest first
+  for (size_t n = 0; n < 3; n++) {
+
+    if (n >= top.size() || top[n].pid != BUSY[3 - n]) {
+
+      printf("ProcessSampler: pid %d is not the number %zu process\n",
+             BUSY[3 - n], n + 1);
+
+      error = 1;
+    }
+  }
+
+  for (pid_t pid = 1; pid <= PROCESSES; pid++) {
+
+    std::string process = synthetic + '/' + std::to_string(pid);
+
+    unlink((process + "/stat").c_str());
+
+    rmdir(process.c_str());
+  }
+
+  rmdir(directory);
+
+  std::vector<struct ProcessSampler::s_process> processes;
+
+  error |= bench(root.c_str(), root, [](int) { usleep(10000); }, processes);
+
+  return error;
+}
@@ -0,0 +1,153 @@
+/**
+ *  @file   ReadBatch.cpp
+ *  @brief  io_uring Batch versus pread(2) Benchmark
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <memory>
+
+#include <string>
+
+#include <utility>
+
+#include <vector>
+
+#include "ProcFile.h"
+#include "ReadBatch.h"
+
+// the files a probe reads with every sensor enabled
+static const std::pair<const char *, ProcFile::Layout> PROBED[] = {
+    {"stat", ProcFile::Layout::Attribute},
+    {"meminfo", ProcFile::Layout::Attribute},
+    {"diskstats", ProcFile::Layout::Table},
+    {"vmstat", ProcFile::Layout::Table},
+    {"net/dev", ProcFile::Layout::Table},
+    {"net/snmp", ProcFile::Layout::Attribute},
+    {"net/netstat", ProcFile::Layout::Attribute},
+    {"pressure/cpu", ProcFile::Layout::Attribute},
+    {"pressure/io", ProcFile::Layout::Attribute},
+    {"pressure/memory", ProcFile::Layout::Attribute},
+    {"interrupts", ProcFile::Layout::Table},
+    {"softirqs", ProcFile::Layout::Attribute},
+    {"self/mountinfo", ProcFile::Layout::Table}};
+
+// Reads the files of a probe ITERATIONS times, one by one with pread(2) and
+// then batched through io_uring, and checks that both read the same lines
+// from each file. Pass another directory than /proc to read a captured
+// copy of it.
+static const int ITERATIONS = 10000;
+
+static long lines(ProcFile &file) {
+
+  return std::count(file.Data(), file.Data() + file.Size(), '\n');
+}
+
+static double probe(std::vector<std::unique_ptr<ProcFile>> &files,
+                    ReadBatch *batch) {
+
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+  for (int n = 0; n < ITERATIONS; n++) {
+
+    for (std::unique_ptr<ProcFile> &file : files) {
+
+      if (batch != nullptr) {
+
+        batch->Add(*file);
+      }
+    }
+
+    if (batch != nullptr) {
+
+      batch->Submit();
+    }
+
+    for (std::unique_ptr<ProcFile> &file : files) {
+
+      file->Read();
+    }
+  }
+
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         ITERATIONS;
+}
+
+int main(int argc, char *argv[]) {
+
+  std::string root = argc > 1 ? argv[1] : "/proc";
+
+  std::vector<std::unique_ptr<ProcFile>> files, references;
+
+  std::vector<const char *> names;
+
+  for (const std::pair<const char *, ProcFile::Layout> &probed : PROBED) {
+
+    std::string path = root + '/' + probed.first;
+
+    std::unique_ptr<ProcFile> file = std::make_unique<ProcFile>();
+
+    if (file->Open(path.c_str(), O_RDONLY, probed.second) != 0) {
+
+      continue;
+    }
+
+    files.push_back(std::move(file));
+
+    names.push_back(probed.first);
+
+    references.push_back(std::make_unique<ProcFile>());
+
+    references.back()->Open(path.c_str(), O_RDONLY, probed.second);
+  }
+
+  ReadBatch batch;
+
+  if (batch.Open() != 0) {
+
+    printf("ReadBatch: io_uring is not available\n");
+
+    return 0;
+  }
+
+  int error = 0;
+
+  for (size_t n = 0; n < files.size(); n++) {
+
+    batch.Add(*files[n]);
+
+    batch.Submit();
+
+    files[n]->Read();
+
+    references[n]->Read();
+
+    // counters tick between the reads, but the rows stay put
+    if (lines(*files[n]) != lines(*references[n])) {
+
+      printf("ReadBatch: %s read %ld lines batched, %ld with pread\n",
+             names[n], lines(*files[n]), lines(*references[n]));
+
+      error = 1;
+    }
+  }
+
+  double pread = probe(files, nullptr), uring = probe(files, &batch);
+
+  printf("ReadBatch: %zu files, pread %.1f us, io_uring %.1f us per probe\n",
+         files.size(), pread, uring);
+
+  return error;
+}
@@ -186,6 +186,18 @@ int ManagedWindow::DrawGLXArc(int x, int y, int radius1, int radius2,
   return 0;
 }
 
+int ManagedWindow::DrawSegments(int x, int y, int radius1, int radius2,
+                                const std::vector<float> &values,
+                                const std::string &color) {
+
+  SetColor(color);
+
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  return DrawGLXSegments(x, y, radius1, radius2, values);
+}
+
 int ManagedWindow::DrawLine(int x1, int y1, int x2, int y2, int width,
                             const std::string &color) {
 
@@ -353,6 +365,65 @@ int ManagedWindow::DrawGLXText(int x, int y, const std::string &text) {
   return 0;
 }
 
+// All segments go out as a single triangle list, one draw call regardless of
+// how many values there are.
+int ManagedWindow::DrawGLXSegments(int x, int y, int radius1, int radius2,
+                                   const std::vector<float> &values) {
+
+  if (values.empty()) {
+
+    return 0;
+  }
+
+  float slot = 2.0 * M_PI / values.size(), gap = 0.2 * slot;
+
+  int nsteps = std::max(1, static_cast<int>(ceilf(slot / (M_PI / 18.0))));
+
+  _glxsegments.clear();
+
+  for (size_t n = 0; n < values.size(); n++) {
+
+    float value = std::clamp(values[n], 0.0f, 1.0f);
+
+    if (value <= 0.0f) {
+
+      continue;
+    }
+
+    float r2 = radius1 + (radius2 - radius1) * value,
+          a1 = M_PI / 2.0 - n * slot - gap / 2.0,
+          da = (gap - slot) / nsteps;
+
+    for (int step = 0; step < nsteps; step++) {
+
+      float cosa1 = cosf(a1 + step * da), sina1 = -sinf(a1 + step * da),
+            cosa2 = cosf(a1 + (step + 1) * da),
+            sina2 = -sinf(a1 + (step + 1) * da);
+
+      GLfloat glxpoints[] = {cosa1 * radius1 + x, sina1 * radius1 + y,
+                             cosa1 * r2 + x,      sina1 * r2 + y,
+                             cosa2 * radius1 + x, sina2 * radius1 + y,
+                             cosa2 * radius1 + x, sina2 * radius1 + y,
+                             cosa1 * r2 + x,      sina1 * r2 + y,
+                             cosa2 * r2 + x,      sina2 * r2 + y};
+
+      _glxsegments.insert(_glxsegments.end(), std::begin(glxpoints),
+                          std::end(glxpoints));
+    }
+  }
+
+  if (!_glxsegments.empty()) {
+
+    glLoadIdentity();
+
+    glVertexPointer(2, GL_FLOAT, 0, _glxsegments.data());
+
+    glDrawArrays(GL_TRIANGLES, 0, _glxsegments.size() / 2);
+  }
+
+  return 0;
+}
+
 int ManagedWindow::DrawGLXLine(int x1, int y1, int x2, int y2, int width) {
 
   float angle = atan2f(y2 - y1, x2 - x1),
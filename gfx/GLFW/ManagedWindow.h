@@ -16,6 +16,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <algorithm>
 #include <functional>
@@ -52,6 +53,9 @@ public:
   int DrawCircle(int x, int y, int radius1, int radius2,
                  const std::string &color);
 
+  int DrawSegments(int x, int y, int radius1, int radius2,
+                   const std::vector<float> &values, const std::string &color);
+
   int DrawLine(int x1, int y1, int x2, int y2, int width,
                const std::string &color);
 
@@ -99,6 +103,8 @@ private:
 
   std::unordered_map<std::string, std::array<unsigned char, 4>> _glxcolors;
 
+  std::vector<GLfloat> _glxsegments;
+
   bool _paused = false;
 
   int SetColor(const std::string &color);
@@ -106,6 +112,9 @@ private:
   int DrawGLXArc(int x, int y, int radius1, int radius2, int angle1,
                  int angle2);
 
+  int DrawGLXSegments(int x, int y, int radius1, int radius2,
+                      const std::vector<float> &values);
+
   int DrawGLXLine(int x1, int y1, int x2, int y2, int width);
 
   int DrawGLXText(int x, int y, const std::string &text);
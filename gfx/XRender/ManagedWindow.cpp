@@ -119,6 +119,15 @@ int ManagedWindow::DrawArc(int x, int y, int radius1, int radius2, int angle1,
   return DrawRenderedArc(x, y, radius1, radius2, angle1, angle2);
 }
 
+int ManagedWindow::DrawSegments(int x, int y, int radius1, int radius2,
+                                const std::vector<float> &values,
+                                const std::string &color) {
+
+  SetColor(color);
+
+  return DrawRenderedSegments(x, y, radius1, radius2, values);
+}
+
 int ManagedWindow::DrawLine(int x1, int y1, int x2, int y2, int width,
                             const std::string &color) {
 
@@ -303,6 +312,72 @@ int ManagedWindow::DrawRenderedArc(int x, int y, int radius1, int radius2,
   return 0;
 }
 
+// All segments go out as a single triangle list, one request regardless of
+// how many values there are.
+int ManagedWindow::DrawRenderedSegments(int x, int y, int radius1, int radius2,
+                                        const std::vector<float> &values) {
+
+  if (values.empty()) {
+    return 0;
+  }
+
+  float slot = 2.0 * M_PI / values.size(), gap = 0.2 * slot;
+
+  int nsteps = std::max(1, static_cast<int>(ceilf(slot / (M_PI / 18.0))));
+
+  _xtriangles.clear();
+
+  for (size_t n = 0; n < values.size(); n++) {
+
+    float value = std::clamp(values[n], 0.0f, 1.0f);
+
+    if (value <= 0.0f) {
+      continue;
+    }
+
+    float r2 = radius1 + (radius2 - radius1) * value,
+          a1 = M_PI / 2.0 - n * slot - gap / 2.0,
+          da = (gap - slot) / nsteps;
+
+    for (int step = 0; step < nsteps; step++) {
+
+      float cosa1 = cosf(a1 + step * da), sina1 = -sinf(a1 + step * da),
+            cosa2 = cosf(a1 + (step + 1) * da),
+            sina2 = -sinf(a1 + (step + 1) * da);
+
+      XTriangle xtriangle[2];
+
+      xtriangle[0].p1.x = XDoubleToFixed(cosa1 * radius1 + x);
+      xtriangle[0].p1.y = XDoubleToFixed(sina1 * radius1 + y);
+
+      xtriangle[0].p2.x = XDoubleToFixed(cosa1 * r2 + x);
+      xtriangle[0].p2.y = XDoubleToFixed(sina1 * r2 + y);
+
+      xtriangle[0].p3.x = XDoubleToFixed(cosa2 * radius1 + x);
+      xtriangle[0].p3.y = XDoubleToFixed(sina2 * radius1 + y);
+
+      xtriangle[1].p1 = xtriangle[0].p3;
+
+      xtriangle[1].p2 = xtriangle[0].p2;
+
+      xtriangle[1].p3.x = XDoubleToFixed(cosa2 * r2 + x);
+      xtriangle[1].p3.y = XDoubleToFixed(sina2 * r2 + y);
+
+      _xtriangles.push_back(xtriangle[0]);
+
+      _xtriangles.push_back(xtriangle[1]);
+    }
+  }
+
+  if (!_xtriangles.empty()) {
+
+    XRenderCompositeTriangles(xdisplay, PictOpAdd, xbrush, xpict, None, 0, 0,
+                              _xtriangles.data(), _xtriangles.size());
+  }
+
+  return 0;
+}
+
 int ManagedWindow::DrawRenderedLine(int x1, int y1, int x2, int y2, int width) {
 
   XTriangle xtriangle[2];
@@ -10,10 +10,12 @@
 #ifndef MANAGEDWINDOW_H_
 #define MANAGEDWINDOW_H_
 
+#include <algorithm>
 #include <cmath>
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <functional>
 #include <memory>
@@ -46,6 +48,9 @@ public:
   int DrawCircle(int x, int y, int radius1, int radius2,
                  const std::string &color);
 
+  int DrawSegments(int x, int y, int radius1, int radius2,
+                   const std::vector<float> &values, const std::string &color);
+
   int DrawLine(int x1, int y1, int x2, int y2, int width,
                const std::string &color);
 
@@ -99,6 +104,8 @@ private:
 
   std::unordered_map<std::string, XRenderColor> _xrendercolors;
 
+  std::vector<XTriangle> _xtriangles;
+
   bool _paused = false;
 
   int SetColor(const std::string &color);
@@ -106,6 +113,9 @@ private:
   int DrawRenderedArc(int x, int y, int radius1, int radius2, int angle1,
                       int angle2);
 
+  int DrawRenderedSegments(int x, int y, int radius1, int radius2,
+                           const std::vector<float> &values);
+
   int DrawRenderedLine(int x1, int y1, int x2, int y2, int width);
 
   int DrawRenderedText(int x, int y, const std::string &text);
@@ -0,0 +1,35 @@
+/**
+ *  @file   Counter.h
+ *  @brief  Kernel Counter Arithmetic
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef COUNTER_H_
+#define COUNTER_H_
+
+#include <cstdint>
+
+// Returns how far a kernel counter moved from then to now. A counter that
+// went down wrapped around when it was close to the top of its range: in
+// the top quarter of 32 bits or the top half of 64 bits. Anywhere else it
+// was reset, e.g. by a device coming back or a row going missing, and the
+// move is unknown, so 0.
+inline unsigned long long counter_delta(unsigned long long now,
+                                        unsigned long long then) {
+
+  if (now >= then) {
+
+    return now - then;
+  }
+
+  if (then <= UINT32_MAX) {
+
+    return then > UINT32_MAX / 4 * 3 ? now + (1ULL << 32) - then : 0;
+  }
+
+  return then >= 1ULL << 63 ? now - then : 0;
+}
+#endif // End of COUNTER_H_
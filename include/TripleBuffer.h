@@ -0,0 +1,76 @@
+/**
+ *  @file   TripleBuffer.h
+ *  @brief  Lock-free Triple Buffer Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef TRIPLEBUFFER_H_
+#define TRIPLEBUFFER_H_
+
+#include <atomic>
+
+// Hands complete values from one writer thread to one reader thread without
+// locks. The writer fills Back() and calls Publish(), the reader calls
+// Acquire() and then reads Front() until its next Acquire(). Each side owns
+// its buffer exclusively; only the index of the spare buffer is exchanged.
+template <typename T> class TripleBuffer {
+
+public:
+  TripleBuffer();
+
+  T &Back();
+
+  void Publish();
+
+  bool Acquire();
+
+  T &Front();
+
+private:
+  static const unsigned char FRESH = 0x4;
+
+  static const unsigned char INDEX = 0x3;
+
+  T _buffers[3];
+
+  std::atomic<unsigned char> _middle;
+
+  unsigned char _back;
+
+  unsigned char _front;
+};
+
+template <typename T>
+inline TripleBuffer<T>::TripleBuffer()
+    : _buffers{}, _middle(1), _back(0), _front(2) {}
+
+template <typename T> inline T &TripleBuffer<T>::Back() {
+
+  return _buffers[_back];
+}
+
+template <typename T> inline void TripleBuffer<T>::Publish() {
+
+  _back = _middle.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+template <typename T> inline bool TripleBuffer<T>::Acquire() {
+
+  if ((_middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+
+    return false;
+  }
+
+  _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX;
+
+  return true;
+}
+
+template <typename T> inline T &TripleBuffer<T>::Front() {
+
+  return _buffers[_front];
+}
+#endif // End of TRIPLEBUFFER_H_
@@ -10,4 +10,7 @@ const unsigned int IN = 0;
 const unsigned int OUT = 1;
 const unsigned int SENT = 0;
 const unsigned int RECV = 1;
+const unsigned int USED = 0;
+const unsigned int BUFFERS = 1;
+const unsigned int CACHE = 2;
 #endif // End of CONFIG_H_
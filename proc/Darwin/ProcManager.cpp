@@ -15,72 +15,359 @@ ProcManager::ProcManager(int argc, char *argv[]) { _init(argc, argv); }
 
 ProcManager::~ProcManager() {
 
-  _terminate_probe_thread = true;
+  {
+    std::lock_guard<std::mutex> lock(_probe_mutex);
+
+    _terminate_probe_thread = true;
+  }
 
   _probe_condition.notify_one();
 
-  _probe_thread.join();
+  if (_probe_thread.joinable()) {
+
+    _probe_thread.join();
+  }
 }
 
 int ProcManager::_init(int argc, char *argv[]) {
 
   _mask = static_cast<int>(ProcManager::Masks::Ignore);
 
-  proc_cpu1 = {0};
+  std::fill(std::begin(_intervals), std::end(_intervals), 2000);
+
+  _stale_interval();
+
+  _sample = {};
+
+  proc_cpu1 = {};
+
+  proc_cpu2 = {};
+
+  proc_eth = {};
+
+  _auto_eth = false;
+
+  _eth_rebase = true;
+
+  proc_io = {};
+
+  proc_vm = {};
+
+  return 0;
+}
+
+int ProcManager::SetInterval(Masks mask, int msec) {
+
+  for (int bit = 0; bit < 32; bit++) {
+
+    if (static_cast<int>(mask) & (1 << bit)) {
 
-  proc_cpu2 = {0};
+      _intervals[bit] = std::max(msec, 1);
+    }
+  }
 
-  proc_eth1 = {0};
+  return _stale_interval();
+}
 
-  proc_eth2 = {0};
+// Bursts never publish a sample of their own, so they do not count.
+int ProcManager::_stale_interval() {
 
-  proc_io1 = {0};
+  int interval = 0, mask = _mask & ~static_cast<int>(Masks::Burst);
 
-  proc_io2 = {0};
+  for (int bit = 0; bit < 32; bit++) {
 
-  _probe_thread = std::thread(&ProcManager::_probe_thread_func, this);
+    if ((mask & (1 << bit)) &&
+        (interval == 0 || _intervals[bit] < interval)) {
+
+      interval = _intervals[bit];
+    }
+  }
+
+  _stale_after = std::chrono::milliseconds(2 * std::max(interval, 1000));
 
   return 0;
 }
 
+// Requests an immediate probe of every sensor and (re)starts the schedule.
+// Never waits for the probe thread: a request that arrives while another is
+// still pending is folded into it. The first request starts the probe
+// thread, so the Set*() calls that precede it are done before the thread
+// reads the configuration; the configuration is not to change after that.
 void ProcManager::Probe() {
 
-  if (_probe_execute) {
+  if (!_probe_thread.joinable()) {
 
-    std::unique_lock<std::mutex> lock(_probe_mutex);
-    _probe_condition.wait(lock, [&] { return !_probe_execute; });
+    _probe_thread = std::thread(&ProcManager::_probe_thread_func, this);
   }
 
-  _probe_execute = true;
+  if (_probe_execute.exchange(true)) {
+
+    return;
+  }
+
+  // taken only to order the flag with the wait, never held during a probe
+  { std::lock_guard<std::mutex> lock(_probe_mutex); }
 
   _probe_condition.notify_one();
 }
 
+int ProcManager::_reschedule() {
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  _schedule = {};
+
+  for (int bit = 0; bit < 32; bit++) {
+
+    if (_mask & (1 << bit)) {
+
+      _schedule.push({now + std::chrono::milliseconds(_intervals[bit]), bit});
+    }
+  }
+
+  return 0;
+}
+
+// Sleeps until the earliest sensor deadline or a request, then probes only
+// the sensors that are due.
 void ProcManager::_probe_thread_func() {
 
   while (true) {
 
-    std::unique_lock<std::mutex> lock(_probe_mutex);
+    int mask = 0;
+
+    bool requested = false;
+
+    {
+      std::unique_lock<std::mutex> lock(_probe_mutex);
+
+      std::function<bool()> wake = [&] {
+        return _probe_execute || _terminate_probe_thread;
+      };
+
+      if (_schedule.empty()) {
+
+        _probe_condition.wait(lock, wake);
+      } else {
+
+        _probe_condition.wait_until(lock, _schedule.top().first, wake);
+      }
+
+      if (_terminate_probe_thread) {
+
+        break;
+      }
+
+      if (_probe_execute) {
+
+        requested = true;
+
+        mask = _mask;
+
+        _reschedule();
+      }
+    }
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+
+    while (!_schedule.empty() && _schedule.top().first <= now) {
+
+      t_deadline deadline = _schedule.top();
+
+      std::chrono::milliseconds interval(_intervals[deadline.second]);
+
+      _schedule.pop();
+
+      mask |= 1 << deadline.second;
+
+      deadline.first += interval;
+
+      // a sensor that missed a whole interval is late, do not catch up; a
+      // burst is late whenever a long probe runs
+      if (deadline.first <= now) {
+
+        if (deadline.second != __builtin_ctz(static_cast<int>(Masks::Burst))) {
+
+          ++_overruns;
+        }
+
+        deadline.first = now + interval;
+      }
+
+      _schedule.push(deadline);
+    }
+
+    // Do burst
+    if ((mask & ~static_cast<int>(Masks::Burst)) == 0) {
+
+      continue;
+    }
+
+    _sample.timestamp = std::chrono::steady_clock::now();
+
+    // a sensor stays in error until it probes fine again
+    _sample.errors = (_sample.errors & ~mask) | _probe(mask);
+
+    _sample.stale = false;
+
+    _sample.overruns = _overruns;
+
+    if (requested) {
+
+      _probe_execute = false;
+    }
+
+    _samples.Back() = _sample;
+
+    _samples.Publish();
+  }
+}
+
+// Turns counters into rates per second over the time between the previous
+// and this read, both taken just before the counters were read; the first
+// read only sets the baseline. Wrapped counters are followed through
+// counter_delta().
+int ProcManager::_rates(const unsigned long long *values, float *const *rates,
+                        int n, struct s_pcounters *counters,
+                        std::chrono::steady_clock::time_point read) {
+
+  float elapsed = std::chrono::duration<float>(read - counters->read).count();
+
+  bool baseline = counters->read.time_since_epoch().count() > 0 && elapsed > 0;
+
+  for (int i = 0; i < n; i++) {
+
+    *rates[i] = baseline ? counter_delta(values[i], counters->values[i]) /
+                               elapsed
+                         : 0.0f;
+
+    counters->values[i] = values[i];
+  }
+
+  counters->read = read;
+
+  return 0;
+}
+
+// Darwin offers no cheap change notification for utmpx, so the database is
+// scanned on the users interval.
+// Asks the routing socket which interface the IPv4 default route uses. An
+// RTM_GET costs a write and a read, so it is simply repeated every probe.
+std::string ProcManager::_default_interface() {
+
+  int fd = socket(PF_ROUTE, SOCK_RAW, AF_INET);
+
+  if (fd < 0) {
+
+    return "";
+  }
+
+  struct {
+    struct rt_msghdr header;
+    struct sockaddr_in addresses[2];
+    char space[512];
+  } message = {};
+
+  message.header.rtm_msglen =
+      sizeof(message.header) + sizeof(message.addresses);
+
+  message.header.rtm_version = RTM_VERSION;
+
+  message.header.rtm_type = RTM_GET;
+
+  message.header.rtm_addrs = RTA_DST | RTA_NETMASK;
+
+  message.header.rtm_seq = 1;
+
+  // destination and netmask 0.0.0.0
+  for (struct sockaddr_in &address : message.addresses) {
+
+    address.sin_len = sizeof(address);
+
+    address.sin_family = AF_INET;
+  }
+
+  pid_t pid = getpid();
+
+  ssize_t n = write(fd, &message, message.header.rtm_msglen);
+
+  while (n > 0 && ((n = read(fd, &message, sizeof(message))) > 0) &&
+         (message.header.rtm_pid != pid || message.header.rtm_seq != 1)) {
+  }
+
+  close(fd);
 
-    _probe_condition.wait(
-        lock, [&] { return _probe_execute || _terminate_probe_thread; });
+  char name[IF_NAMESIZE];
 
-    if (_terminate_probe_thread) {
+  if (n <= 0 || message.header.rtm_errno != 0 ||
+      if_indextoname(message.header.rtm_index, name) == nullptr) {
 
-      break;
+    return "";
+  }
+
+  return std::string(name);
+}
+
+int ProcManager::_scan_users() {
+
+  std::unordered_set<std::string> logged_in;
+
+  std::vector<std::string> users;
+
+  setutxent();
+
+  struct utmpx *s_utmpx;
+
+  while ((s_utmpx = getutxent()) != NULL) {
+
+    if (s_utmpx->ut_type != USER_PROCESS) {
+
+      continue;
+    }
+
+    // ut_user is not NUL terminated when the name fills the field
+    std::string user(s_utmpx->ut_user,
+                     strnlen(s_utmpx->ut_user, sizeof(s_utmpx->ut_user)));
+
+    if (logged_in.insert(user).second) {
+
+      users.push_back(user);
     }
+  }
+
+  endutxent();
+
+  for (const std::string &user : users) {
+
+    if (_logged_in.find(user) == _logged_in.end()) {
 
-    _probe();
+      _sample.logins.push_back(user);
+    }
+  }
 
-    _probe_execute = false;
+  for (const std::string &user : _logged_in) {
 
-    _probe_condition.notify_one();
+    if (logged_in.find(user) == logged_in.end()) {
+
+      _sample.logouts.push_back(user);
+    }
   }
+
+  _logged_in.swap(logged_in);
+
+  _sample.users.swap(users);
+
+  return 0;
 }
 
-int ProcManager::_probe() {
+// Probes the sensors in mask and returns those that failed; a failing
+// sensor keeps its previous values and does not hold up the others.
+int ProcManager::_probe(int mask) {
 
-  if (_mask & Masks::CPU) {
+  int failed = 0;
+
+  if (mask & Masks::CPU) {
 
     processor_cpu_load_info_t cpu_info;
 
@@ -96,8 +383,33 @@ int ProcManager::_probe() {
 
       memset(&proc_cpu2, 0, sizeof(struct s_pcpu));
 
+      proc_cores2.busy.resize(ncpu, 0);
+
+      proc_cores2.total.resize(ncpu, 0);
+
+      proc_cores1.busy.resize(ncpu, 0);
+
+      proc_cores1.total.resize(ncpu, 0);
+
+      _sample.cores.resize(ncpu, 0.0f);
+
       while (ncpu--) {
 
+        proc_cores2.busy[ncpu] = cpu_info[ncpu].cpu_ticks[CPU_STATE_USER] +
+                                 cpu_info[ncpu].cpu_ticks[CPU_STATE_NICE] +
+                                 cpu_info[ncpu].cpu_ticks[CPU_STATE_SYSTEM];
+
+        proc_cores2.total[ncpu] = proc_cores2.busy[ncpu] +
+                                  cpu_info[ncpu].cpu_ticks[CPU_STATE_IDLE];
+
+        float total = proc_cores2.total[ncpu] - proc_cores1.total[ncpu];
+
+        if (total > 0.0f) {
+
+          _sample.cores[ncpu] =
+              (proc_cores2.busy[ncpu] - proc_cores1.busy[ncpu]) / total;
+        }
+
         proc_cpu2.user +=
             static_cast<float>(cpu_info[ncpu].cpu_ticks[CPU_STATE_USER]);
 
@@ -118,20 +430,44 @@ int ProcManager::_probe() {
 
       if (diff > 0.0f) {
 
-        cpu.user = (proc_cpu2.user - proc_cpu1.user) / diff;
+        _sample.cpu.user = (proc_cpu2.user - proc_cpu1.user) / diff;
+
+        _sample.cpu.nice = (proc_cpu2.nice - proc_cpu1.nice) / diff;
 
-        cpu.nice = (proc_cpu2.nice - proc_cpu1.nice) / diff;
+        _sample.cpu.sys = (proc_cpu2.sys - proc_cpu1.sys) / diff;
 
-        cpu.sys = (proc_cpu2.sys - proc_cpu1.sys) / diff;
+        _sample.cpu.idle = (proc_cpu2.idle - proc_cpu1.idle) / diff;
 
-        cpu.idle = (proc_cpu2.idle - proc_cpu1.idle) / diff;
+        _sample.cpu.iowait = _sample.cpu.steal = 0.0f;
 
         proc_cpu1 = proc_cpu2;
       }
+
+      proc_cores1 = proc_cores2;
+    } else {
+
+      failed |= static_cast<int>(Masks::CPU);
     }
   }
 
-  if (_mask & Masks::Eth) {
+  if (mask & Masks::Eth) {
+
+    if (_auto_eth) {
+
+      std::string eth = _default_interface();
+
+      if (!eth.empty() && eth != _eth) {
+
+        _eth = eth;
+
+        _eth_rebase = true;
+      }
+    }
+
+    unsigned long long values[2] = {proc_eth.values[0], proc_eth.values[1]};
+
+    std::chrono::steady_clock::time_point read =
+        std::chrono::steady_clock::now();
 
     unsigned int ifindex = if_nametoindex(_eth.c_str());
 
@@ -159,23 +495,45 @@ int ProcManager::_probe() {
             continue;
           }
 
-          proc_eth2.received = if_msghdr2_s.ifm_data.ifi_ibytes;
+          values[0] = if_msghdr2_s.ifm_data.ifi_ibytes;
 
-          proc_eth2.sent = if_msghdr2_s.ifm_data.ifi_obytes;
+          values[1] = if_msghdr2_s.ifm_data.ifi_obytes;
         }
       }
 
       free(records);
     }
 
-    eth.received = proc_eth2.received - proc_eth1.received;
+    // the counters of another interface are a new baseline
+    if (_eth_rebase) {
+
+      proc_eth.read = {};
+
+      _eth_rebase = false;
+    }
+
+    float *const rates[] = {&_sample.eth.received, &_sample.eth.sent};
+
+    _rates(values, rates, 2, &proc_eth, read);
 
-    eth.sent = proc_eth2.sent - proc_eth1.sent;
+    // without bursts the ranges are the means
+    _sample.burst.received = {_sample.eth.received, _sample.eth.received,
+                              _sample.eth.received};
 
-    proc_eth1 = proc_eth2;
+    _sample.burst.sent = {_sample.eth.sent, _sample.eth.sent,
+                          _sample.eth.sent};
   }
 
-  if (_mask & Masks::IO) {
+  if (mask & Masks::IO) {
+
+    // bytes read and written, requests and their total service time in ns;
+    // without the registry the counters stand still
+    unsigned long long values[4];
+
+    std::copy(std::begin(proc_io.values), std::end(proc_io.values), values);
+
+    std::chrono::steady_clock::time_point read =
+        std::chrono::steady_clock::now();
 
     mach_port_t master_port = kIOMainPortDefault;
 
@@ -196,7 +554,7 @@ int ProcManager::_probe() {
 
       long io_read, io_write, io_read_total = 0L, io_write_total = 0L;
 
-      memset(&proc_io2, 0, sizeof(struct s_pio));
+      std::fill(std::begin(values), std::end(values), 0ULL);
 
       while ((drive = IOIteratorNext(drive_list))) {
 
@@ -244,14 +602,36 @@ int ProcManager::_probe() {
 
             CFNumberGetValue(nValue, kCFNumberSInt64Type, &io_read);
 
-            proc_io2.read += io_read;
+            values[0] += io_read;
 
             nValue = (CFNumberRef)CFDictionaryGetValue(
                 stats, CFSTR(kIOBlockStorageDriverStatisticsBytesWrittenKey));
 
             CFNumberGetValue(nValue, kCFNumberSInt64Type, &io_write);
 
-            proc_io2.write += io_write;
+            values[1] += io_write;
+
+            const CFStringRef keys[2][2] = {
+                {CFSTR(kIOBlockStorageDriverStatisticsReadsKey),
+                 CFSTR(kIOBlockStorageDriverStatisticsTotalReadTimeKey)},
+                {CFSTR(kIOBlockStorageDriverStatisticsWritesKey),
+                 CFSTR(kIOBlockStorageDriverStatisticsTotalWriteTimeKey)}};
+
+            for (const CFStringRef *pair : keys) {
+
+              for (int i = 0; i < 2; i++) {
+
+                long value = 0;
+
+                nValue = (CFNumberRef)CFDictionaryGetValue(stats, pair[i]);
+
+                if (nValue &&
+                    CFNumberGetValue(nValue, kCFNumberSInt64Type, &value)) {
+
+                  values[2 + i] += value;
+                }
+              }
+            }
 
             IOObjectRelease(parent);
 
@@ -265,19 +645,30 @@ int ProcManager::_probe() {
 
     IOObjectRelease(drive_list);
 
-    io.read = proc_io2.read - proc_io1.read;
+    float requests, time;
 
-    io.write = proc_io2.write - proc_io1.write;
+    float *const rates[] = {&_sample.io.read, &_sample.io.write, &requests,
+                            &time};
 
-    proc_io1 = proc_io2;
+    _rates(values, rates, 4, &proc_io, read);
+
+    // IOKit keeps no busy time, so only the await of all disks is known
+    _sample.io.await = requests > 0.0f ? 1e-6f * time / requests : 0.0f;
+
+    _sample.io.utilization = _sample.io.queue = 0.0f;
+
+    _sample.burst.read = {_sample.io.read, _sample.io.read, _sample.io.read};
+
+    _sample.burst.write = {_sample.io.write, _sample.io.write,
+                           _sample.io.write};
   }
 
-  if (_mask & Masks::EMail) {
+  if (mask & Masks::EMail) {
 
     // Do Email
   }
 
-  if (_mask & Masks::Host) {
+  if (mask & Masks::Host) {
 
     char *user = getenv("USER"), *host = getenv("HOST");
 
@@ -294,12 +685,12 @@ int ProcManager::_probe() {
     }
   }
 
-  if (_mask & Masks::Alarm) {
+  if (mask & Masks::Alarm) {
 
     // Do Alarm
   }
 
-  if (_mask & Masks::Mem) {
+  if (mask & Masks::Mem) {
 
     mach_msg_type_number_t count = HOST_VM_INFO_COUNT;
 
@@ -309,64 +700,76 @@ int ProcManager::_probe() {
                                         (host_info_t)&vm_stat, &count);
     if (KERN_SUCCESS == err) {
 
-      struct sysinfo {
-        unsigned long totalram;  /* Total usable main memory size */
-        unsigned long freeram;   /* Available memory size */
-        unsigned long sharedram; /* Amount of shared memory */
-        unsigned long bufferram; /* Memory used by buffers */
-      };
+      _sample.memory.total =
+          vm_page_size * (vm_stat.active_count + vm_stat.inactive_count +
+                          vm_stat.wire_count + vm_stat.free_count);
 
-      memory.freeram = vm_stat.free_count;
+      _sample.memory.free = vm_page_size * vm_stat.free_count;
 
-      memory.totalram = vm_stat.active_count + vm_stat.inactive_count +
-                        vm_stat.wire_count + vm_stat.free_count;
+      // inactive pages are the closest Darwin has to a reclaimable cache
+      _sample.memory.cached = vm_page_size * vm_stat.inactive_count;
 
-      memory.sharedram = vm_stat.active_count;
+      _sample.memory.buffers = 0;
 
-      memory.bufferram = vm_stat.inactive_count;
+      _sample.memory.available = _sample.memory.free + _sample.memory.cached;
     }
   }
 
-  if (_mask & Masks::Disk) {
+  if (mask & Masks::Disk) {
 
-    if (statfs(_disk.c_str(), &disk) != 0) {
+    _sample.disks.clear();
 
-      return 1;
-    }
-  }
+    if (_disk == "*") {
 
-  if (_mask & Masks::Users) {
+      struct statfs *mounts;
 
-    setutxent();
+      // MNT_NOWAIT returns cached figures and never blocks on a hung mount
+      int nmounts = getmntinfo(&mounts, MNT_NOWAIT);
 
-    struct utmpx *s_utmpx;
+      for (int n = 0; n < nmounts; n++) {
 
-    while ((s_utmpx = getutxent()) != NULL) {
+        if (mounts[n].f_flags & MNT_LOCAL) {
 
-      if (s_utmpx->ut_type == USER_PROCESS) {
+          _sample.disks.push_back({mounts[n].f_mntonname, mounts[n].f_blocks,
+                                   mounts[n].f_bfree, mounts[n].f_bavail,
+                                   false});
+        }
+      }
+    } else {
 
-        int s;
+      std::string::size_type start = 0, end;
 
-        for (s = users.size(); s--;) {
+      do {
 
-          if (std::find(users.begin(), users.end(),
-                        std::string(s_utmpx->ut_user)) != users.end()) {
+        end = _disk.find(',', start);
 
-            break;
-          }
-        }
+        std::string path = _disk.substr(start, end - start);
 
-        if (s < 0) {
+        start = end + 1;
 
-          users.emplace_back(s_utmpx->ut_user);
+        struct statfs disk;
+
+        if (!path.empty() && statfs(path.c_str(), &disk) == 0) {
+
+          _sample.disks.push_back(
+              {path, disk.f_blocks, disk.f_bfree, disk.f_bavail, false});
         }
-      }
+      } while (end != std::string::npos);
     }
+  }
 
-    endutxent();
+  if (mask & Masks::Users) {
+
+    // logins and logouts are relative to the previous probe of the users,
+    // and are published along with whatever is probed until the next one
+    _sample.logins.clear();
+
+    _sample.logouts.clear();
+
+    _scan_users();
   }
 
-  if (_mask & Masks::Battery) {
+  if (mask & Masks::Battery) {
 
     CFTypeRef blob = IOPSCopyPowerSourcesInfo();
 
@@ -399,7 +802,7 @@ int ProcManager::_probe() {
 
     CFNumberGetValue(nValue, kCFNumberSInt64Type, &maxCapacity);
 
-    battery = {.powerstate = PowerStates::Unknown,
+    _sample.battery = {.powerstate = PowerStates::Unknown,
                .level = static_cast<float>(currentCapacity) /
                         static_cast<float>(maxCapacity)};
 
@@ -417,10 +820,10 @@ int ProcManager::_probe() {
 
       if (CFBooleanGetValue(bValue)) {
 
-        battery.powerstate = PowerStates::BatteryCharging;
+        _sample.battery.powerstate = PowerStates::BatteryCharging;
       } else {
 
-        battery.powerstate = PowerStates::ACPower;
+        _sample.battery.powerstate = PowerStates::ACPower;
       }
     } else if (kCFCompareEqualTo ==
                CFStringCompare(CFSTR(kIOPSBatteryPowerValue), sValue, 0)) {
@@ -428,7 +831,7 @@ int ProcManager::_probe() {
       nValue =
           (CFNumberRef)CFDictionaryGetValue(source, CFSTR(kIOPSTimeToEmptyKey));
 
-      battery.powerstate = PowerStates::BatteryDischarging;
+      _sample.battery.powerstate = PowerStates::BatteryDischarging;
     }
 
     CFRelease(blob);
@@ -436,5 +839,73 @@ int ProcManager::_probe() {
     CFRelease(sources);
   }
 
-  return 0;
+  if (mask & Masks::Pressure) {
+
+    // Do pressure, Darwin has no pressure stall information
+    _sample.pressure = {};
+  }
+
+  if (mask & Masks::Cgroups) {
+
+    // Do cgroups, Darwin has no control groups
+    _sample.cgroups.clear();
+  }
+
+  if (mask & Masks::Processes) {
+
+    // Do processes
+    _sample.processes.clear();
+  }
+
+  if (mask & Masks::Sensors) {
+
+    // Do sensors
+    _sample.sensors = {};
+  }
+
+  if (mask & Masks::Interrupts) {
+
+    // Do interrupts
+    _sample.interrupts = {};
+  }
+
+  if (mask & Masks::Perf) {
+
+    // Do perf
+    _sample.perf = {};
+  }
+
+  if (mask & Masks::VM) {
+
+    mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+
+    vm_statistics64_data_t vm_stat;
+
+    std::chrono::steady_clock::time_point read =
+        std::chrono::steady_clock::now();
+
+    if (KERN_SUCCESS == host_statistics64(mach_host_self(), HOST_VM_INFO64,
+                                          (host_info64_t)&vm_stat, &count)) {
+
+      // pageins are the closest Darwin has to major faults
+      unsigned long long values[4] = {vm_stat.faults, vm_stat.pageins,
+                                      vm_stat.swapins, vm_stat.swapouts};
+
+      float *const rates[] = {&_sample.vm.faults, &_sample.vm.majfaults,
+                              &_sample.vm.swapin, &_sample.vm.swapout};
+
+      _rates(values, rates, 4, &proc_vm, read);
+    } else {
+
+      failed |= static_cast<int>(Masks::VM);
+    }
+  }
+
+  if (mask & Masks::TCP) {
+
+    // Do tcp
+    _sample.tcp = {};
+  }
+
+  return failed;
 }
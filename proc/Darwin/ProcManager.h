@@ -22,8 +22,10 @@
 #include <mach/mach.h>
 #include <mach/mach_host.h>
 #include <mach/processor_info.h>
+#include <sys/socket.h>
 #include <sys/sysctl.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <net/if.h>
 #include <net/if_dl.h>
@@ -31,6 +33,7 @@
 #include <net/if_types.h>
 #include <net/if_var.h>
 #include <net/route.h>
+#include <netinet/in.h>
 
 #include <utmpx.h>
 
@@ -44,10 +47,23 @@
 
 #include <algorithm>
 
+#include <atomic>
+
+#include <chrono>
+
 #include <condition_variable>
 
+#include <functional>
+
+#include <queue>
+
 #include <thread>
 
+#include <unordered_set>
+
+#include "Counter.h"
+#include "TripleBuffer.h"
+
 #include <CoreFoundation/CFString.h>
 #include <CoreFoundation/CoreFoundation.h>
 #include <IOKit/IOBSD.h>
@@ -65,11 +81,8 @@
 class ProcManager {
 
 public:
-  struct sysinfo {
-    unsigned long totalram;  /* Total usable main memory size */
-    unsigned long freeram;   /* Available memory size */
-    unsigned long sharedram; /* Amount of shared memory */
-    unsigned long bufferram; /* Memory used by buffers */
+  struct s_memory {
+    unsigned long total, free, available, buffers, cached;
   };
 
   enum class Masks {
@@ -84,24 +97,53 @@ public:
     Host = 1L << 8,
     Users = 1L << 9,
     Battery = 1L << 10,
-    All = 1L << 12
+    Pressure = 1L << 11,
+    Cgroups = 1L << 12,
+    VM = 1L << 13,
+    TCP = 1L << 14,
+    Processes = 1L << 15,
+    Burst = 1L << 16,
+    Sensors = 1L << 17,
+    Interrupts = 1L << 18,
+    Perf = 1L << 19,
+    All = 1L << 20
   };
 
   struct s_cpu {
-    float user, nice, sys, idle;
-  } cpu;
-
-  struct sysinfo memory;
-
-  struct statfs disk;
+    float user, nice, sys, idle, iowait, steal;
+  };
 
   struct s_eth {
-    unsigned long received, sent;
-  } eth;
+    float received, sent;
+  };
 
   struct s_io {
-    unsigned long read, write;
-  } io;
+    float read, write, utilization, queue, await;
+  };
+
+  struct s_vm {
+    float faults, majfaults, swapin, swapout;
+  };
+
+  struct s_tcp {
+    float retransmits, listendrops, listenoverflows;
+  };
+
+  struct s_range {
+    float min, max, mean;
+  };
+
+  struct s_burst {
+    struct s_range received, sent, read, write;
+  };
+
+  struct s_stall {
+    float some, full;
+  };
+
+  struct s_pressure {
+    struct s_stall cpu, memory, io;
+  };
 
   enum class PowerStates {
     Unknown,
@@ -114,11 +156,65 @@ public:
   struct s_battery {
     PowerStates powerstate;
     float level;
-  } battery;
+  };
+
+  struct s_disk {
+    std::string path;
+    unsigned long blocks, bfree, bavail;
+    bool stale;
+  };
+
+  struct s_cgroup {
+    std::string name;
+    float cpu, io;
+    unsigned long memory;
+  };
 
-  std::string host;
+  struct s_process {
+    pid_t pid;
+    std::string name;
+    float cpu;
+    unsigned long memory;
+  };
 
-  std::vector<std::string> users;
+  struct s_sensors {
+    std::vector<float> frequencies, temperatures;
+    float heat;
+  };
+
+  struct s_interrupts {
+    std::vector<float> hardirqs, softirqs;
+  };
+
+  struct s_perf {
+    float switches, faults, migrations, ipc;
+    bool software, hardware;
+  };
+
+  struct s_sample {
+    struct s_cpu cpu;
+    std::vector<float> cores;
+    struct s_memory memory;
+    std::vector<struct s_disk> disks;
+    std::vector<struct s_cgroup> cgroups;
+    std::vector<struct s_process> processes;
+    struct s_eth eth;
+    struct s_io io;
+    struct s_battery battery;
+    struct s_pressure pressure;
+    struct s_vm vm;
+    struct s_tcp tcp;
+    struct s_burst burst;
+    struct s_sensors sensors;
+    struct s_interrupts interrupts;
+    struct s_perf perf;
+    std::string host;
+    std::vector<std::string> users, logins, logouts;
+    std::chrono::steady_clock::time_point timestamp;
+    unsigned long overruns;
+    int errors;
+    bool stale;
+  };
 
   ProcManager();
 
@@ -136,30 +232,59 @@ public:
 
   int SetIO(const char *io);
 
+  int SetCgroups(int top);
+
+  int SetProcesses(int top);
+
+  int SetUring(bool uring);
+
+  int SetInterval(Masks mask, int msec);
+
+  int GetInterval(Masks mask);
+
   void Probe();
 
+  const struct s_sample &Snapshot();
+
 private:
   int _init(int argc, char *argv[]);
 
-  int _probe();
+  int _probe(int mask);
+
+  int _reschedule();
+
+  int _stale_interval();
+
+  int _scan_users();
+
+  static std::string _default_interface();
+
+  struct s_pcounters {
+    unsigned long long values[4];
+    std::chrono::steady_clock::time_point read;
+  } proc_eth, proc_io, proc_vm;
+
+  static int _rates(const unsigned long long *values, float *const *rates,
+                    int n, struct s_pcounters *counters,
+                    std::chrono::steady_clock::time_point read);
 
   void _probe_thread_func();
 
   int _mask;
 
+  struct s_sample _sample;
+
+  TripleBuffer<struct s_sample> _samples;
+
   struct s_pcpu {
 
     unsigned long user, nice, sys, idle, total;
   } proc_cpu1, proc_cpu2;
 
-  struct s_peth {
+  struct s_pcores {
 
-    unsigned long received, sent;
-  } proc_eth1, proc_eth2;
-
-  struct s_pio {
-    unsigned long read, write;
-  } proc_io1, proc_io2;
+    std::vector<unsigned long> busy, total;
+  } proc_cores1, proc_cores2;
 
   std::string _disk;
 
@@ -167,10 +292,24 @@ private:
 
   std::string _eth;
 
+  bool _auto_eth, _eth_rebase;
+
   std::string _io;
 
   std::string _host;
 
+  std::unordered_set<std::string> _logged_in;
+
+  int _intervals[32];
+
+  std::chrono::milliseconds _stale_after;
+
+  typedef std::pair<std::chrono::steady_clock::time_point, int> t_deadline;
+
+  std::priority_queue<t_deadline, std::vector<t_deadline>,
+                      std::greater<t_deadline>>
+      _schedule;
+
   std::thread _probe_thread;
 
   std::condition_variable _probe_condition;
@@ -179,7 +318,9 @@ private:
 
   bool _terminate_probe_thread = false;
 
-  bool _probe_execute = false;
+  std::atomic<bool> _probe_execute{false};
+
+  std::atomic<unsigned long> _overruns{0};
 };
 
 inline int operator&(int a, ProcManager::Masks b) {
@@ -216,13 +357,24 @@ inline int ProcManager::SetCPU(const char *cpu) {
   return 0;
 }
 
+// "auto" follows the interface of the default route
 inline int ProcManager::SetEth(const char *eth) {
 
-  _eth = std::string(eth);
+  _auto_eth = strcmp(eth, "auto") == 0;
+
+  _eth = std::string(_auto_eth ? "" : eth);
+
+  _eth_rebase = true;
 
   return 0;
 }
 
+inline int ProcManager::SetCgroups(int top) { return 0; }
+
+inline int ProcManager::SetProcesses(int top) { return 0; }
+
+inline int ProcManager::SetUring(bool uring) { return 0; }
+
 inline int ProcManager::SetIO(const char *io) {
 
   _io = std::string(io);
@@ -234,6 +386,27 @@ inline int ProcManager::SetProcMask(int mask) {
 
   _mask = mask;
 
-  return 0;
+  return _stale_interval();
+}
+
+inline int ProcManager::GetInterval(Masks mask) {
+
+  return _intervals[__builtin_ctz(static_cast<int>(mask))];
+}
+// A sample is stale once it is older than twice the shortest interval.
+// Until the probe thread first publishes, Snapshot() hands out an empty
+// sample without a timestamp, which is not stale but not there yet.
+inline const struct ProcManager::s_sample &ProcManager::Snapshot() {
+
+  _samples.Acquire();
+
+  if (_samples.Front().timestamp.time_since_epoch().count() > 0 &&
+      std::chrono::steady_clock::now() - _samples.Front().timestamp >
+          _stale_after) {
+
+    _samples.Front().stale = true;
+  }
+
+  return _samples.Front();
 }
 #endif // End of PROCMANAGER_H_
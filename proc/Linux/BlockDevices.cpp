@@ -0,0 +1,346 @@
+/**
+ *  @file   BlockDevices.cpp
+ *  @brief  Linux Block Device I/O Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "BlockDevices.h"
+
+static const char *SYS_BLOCK = "/sys/block/";
+
+static const char *SYS_CLASS_BLOCK = "/sys/class/block/";
+
+static bool has_entries(const std::string &path) {
+
+  DIR *dir = opendir(path.c_str());
+
+  if (dir == nullptr) {
+
+    return false;
+  }
+
+  struct dirent *entry;
+
+  while ((entry = readdir(dir)) != nullptr && entry->d_name[0] == '.') {
+  }
+
+  closedir(dir);
+
+  return entry != nullptr;
+}
+
+BlockDevices::BlockDevices() : _discovered(false) {
+
+  _diskstats.Open("/proc/diskstats", O_RDONLY, ProcFile::Layout::Table);
+}
+
+int BlockDevices::_add(const std::string &device) {
+
+  ProcFile dev;
+
+  struct s_device entry = {};
+
+  if (dev.Open((device + "/dev").c_str()) != 0 || dev.Read() != 0 ||
+      sscanf(dev.Data(), "%lu:%lu", &entry.major, &entry.minor) != 2) {
+
+    return 1;
+  }
+
+  entry.name = device.substr(device.rfind('/') + 1);
+
+  _selected.push_back(entry);
+
+  return 0;
+}
+
+int BlockDevices::_discover() {
+
+  std::vector<struct s_device> previous;
+
+  previous.swap(_selected);
+
+  _discovered = true;
+
+  if (_devices == "*" || _devices == "." || _devices.empty()) {
+
+    DIR *dir = opendir(SYS_BLOCK);
+
+    struct dirent *entry;
+
+    while (dir != nullptr && (entry = readdir(dir)) != nullptr) {
+
+      const char *name = entry->d_name;
+
+      if (name[0] == '.' || strncmp(name, "loop", 4) == 0 ||
+          strncmp(name, "ram", 3) == 0 || strncmp(name, "zram", 4) == 0) {
+
+        continue;
+      }
+
+      std::string device = std::string(SYS_BLOCK) + name;
+
+      // dm and md devices would count the I/O of their disks twice
+      if (!has_entries(device + "/slaves")) {
+
+        _add(device);
+      }
+    }
+
+    if (dir != nullptr) {
+
+      closedir(dir);
+    }
+  } else {
+
+    std::string::size_type start = 0, end;
+
+    do {
+
+      end = _devices.find(',', start);
+
+      std::string name = _devices.substr(start, end - start);
+
+      start = end + 1;
+
+      if (!name.empty()) {
+
+        _add(SYS_CLASS_BLOCK + name);
+      }
+    } while (end != std::string::npos);
+  }
+
+  // devices that stay keep their counters as the baseline
+  for (struct s_device &device : _selected) {
+
+    for (const struct s_device &old : previous) {
+
+      if (old.major == device.major && old.minor == device.minor) {
+
+        device.counted = old.counted;
+
+        device.burst_counted = old.burst_counted;
+
+        std::copy(std::begin(old.counters), std::end(old.counters),
+                  std::begin(device.counters));
+
+        std::copy(std::begin(old.burst), std::end(old.burst),
+                  std::begin(device.burst));
+      }
+    }
+  }
+
+  return 0;
+}
+
+// Finds the row of each device, searching on from the row of the previous
+// device and only from the top when that fails, then takes the device's
+// counters into update. A search from the top means the table changed, and
+// the devices are sorted anew for the next read.
+int BlockDevices::_parse() {
+
+  const char *fields[14];
+
+  size_t lengths[14];
+
+  LineScanner scanner(_diskstats.Data(), _diskstats.Size());
+
+  bool reordered = false;
+
+  for (struct s_device &device : _selected) {
+
+    if (!scanner.FindLine(device.name.data(), device.name.size(), 2)) {
+
+      scanner = LineScanner(_diskstats.Data(), _diskstats.Size());
+
+      reordered = true;
+
+      if (!scanner.FindLine(device.name.data(), device.name.size(), 2)) {
+
+        device.found = false;
+
+        continue;
+      }
+    }
+
+    device.row = scanner.Line() - _diskstats.Data();
+
+    // "major minor name reads merged sectors ms writes merged sectors ms
+    // in_flight io_ticks time_in_queue ..."
+    device.found =
+        scanner.Fields(fields, lengths, 14) == 14 &&
+        LineScanner::Decimal(fields[0], lengths[0]) == device.major &&
+        LineScanner::Decimal(fields[1], lengths[1]) == device.minor;
+
+    if (!device.found) {
+
+      continue;
+    }
+
+    unsigned long long *update = device.update;
+
+    update[SectorsRead] = LineScanner::Decimal(fields[5], lengths[5]);
+
+    update[SectorsWritten] = LineScanner::Decimal(fields[9], lengths[9]);
+
+    update[Requests] = LineScanner::Decimal(fields[3], lengths[3]) +
+                       LineScanner::Decimal(fields[7], lengths[7]);
+
+    update[RequestTime] = LineScanner::Decimal(fields[6], lengths[6]) +
+                          LineScanner::Decimal(fields[10], lengths[10]);
+
+    update[BusyTime] = LineScanner::Decimal(fields[12], lengths[12]);
+
+    update[QueueTime] = LineScanner::Decimal(fields[13], lengths[13]);
+  }
+
+  if (reordered) {
+
+    std::sort(_selected.begin(), _selected.end(),
+              [](const struct s_device &a, const struct s_device &b) {
+                return a.row < b.row;
+              });
+  }
+
+  return 0;
+}
+
+// Reads /proc/diskstats and parses the rows of the devices.
+int BlockDevices::_read() {
+
+  if (!_discovered) {
+
+    _discover();
+  }
+
+  if (_diskstats.Read() != 0) {
+
+    return 1;
+  }
+
+  return _parse();
+}
+
+int BlockDevices::_lookup(struct s_io &io,
+                          std::chrono::steady_clock::time_point now) {
+
+  float elapsed =
+      std::chrono::duration<float, std::milli>(now - _sampled).count();
+
+  _sampled = now;
+
+  io = {};
+
+  for (struct s_device &device : _selected) {
+
+    if (!device.found) {
+
+      continue;
+    }
+
+    unsigned long long delta[NCounters];
+
+    for (int n = 0; n < NCounters; n++) {
+
+      delta[n] = counter_delta(device.update[n], device.counters[n]);
+
+      device.counters[n] = device.update[n];
+    }
+
+    if (!device.counted || elapsed <= 0.0f) {
+
+      device.counted = true;
+
+      continue;
+    }
+
+    io.read += 512000.0f * delta[SectorsRead] / elapsed;
+
+    io.written += 512000.0f * delta[SectorsWritten] / elapsed;
+
+    float utilization = std::min(delta[BusyTime] / elapsed, 1.0f);
+
+    if (utilization >= io.utilization) {
+
+      io.utilization = utilization;
+
+      io.queue = delta[QueueTime] / elapsed;
+
+      io.await = delta[Requests] > 0
+                     ? static_cast<float>(delta[RequestTime]) / delta[Requests]
+                     : 0.0f;
+    }
+  }
+
+  return 0;
+}
+
+// Returns the bytes per second read and written since the previous sample,
+// and the utilization (0-1), average queue depth and await (ms) of the
+// busiest device over that time, all measured against the time that really
+// passed between the reads. A device that has just been added contributes
+// from its second sample on.
+int BlockDevices::Sample(struct s_io &io) {
+
+  io = {};
+
+  if (_read() != 0) {
+
+    return 1;
+  }
+
+  return _lookup(io, _diskstats.ReadTime());
+}
+
+// Only the sectors are followed, against a baseline of their own; 1 on the
+// first call, which only sets that baseline.
+int BlockDevices::SampleBurst(float &read, float &written) {
+
+  read = written = 0.0f;
+
+  if (_read() != 0) {
+
+    return 1;
+  }
+
+  std::chrono::steady_clock::time_point now = _diskstats.ReadTime();
+
+  bool baseline = _burst_sampled.time_since_epoch().count() == 0;
+
+  float elapsed =
+      std::chrono::duration<float, std::milli>(now - _burst_sampled).count();
+
+  _burst_sampled = now;
+
+  for (struct s_device &device : _selected) {
+
+    if (!device.found) {
+
+      continue;
+    }
+
+    unsigned long long delta[SectorsWritten + 1];
+
+    for (int n = SectorsRead; n <= SectorsWritten; n++) {
+
+      delta[n] = counter_delta(device.update[n], device.burst[n]);
+
+      device.burst[n] = device.update[n];
+    }
+
+    if (!device.burst_counted || elapsed <= 0.0f) {
+
+      device.burst_counted = true;
+
+      continue;
+    }
+
+    read += 512000.0f * delta[SectorsRead] / elapsed;
+
+    written += 512000.0f * delta[SectorsWritten] / elapsed;
+  }
+
+  return baseline ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+/**
+ *  @file   BlockDevices.h
+ *  @brief  Linux Block Device I/O Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef BLOCKDEVICES_H_
+#define BLOCKDEVICES_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <string>
+
+#include <vector>
+
+#include "Counter.h"
+#include "LineScanner.h"
+#include "ProcFile.h"
+#include "ReadBatch.h"
+
+// Sums the bytes per second read and written by a set of block devices from
+// /proc/diskstats, and reports the utilization, average queue depth and await
+// of the busiest of them from the time fields of the same rows. "*" (or ".")
+// selects every whole disk in /sys/block, leaving out loop, ram and zram
+// devices and the device-mapper and md devices stacked on top of other disks;
+// otherwise a comma separated list of names, partitions included, is taken as
+// is. The row of a device is found by its name and checked against its
+// major:minor, so a sample splits only those rows. The devices are kept in the
+// order of the table, each search picking up where the previous one stopped.
+// Invalidate() redoes the discovery, e.g. after a block hotplug uevent.
+// Prefetch() queues /proc/diskstats on a ReadBatch ahead of Sample().
+// SampleBurst() measures the bytes per second since its own previous call,
+// leaving the interval of Sample() alone, so it can run many times in between.
+class BlockDevices {
+
+public:
+  struct s_io {
+    float read, written, utilization, queue, await;
+  };
+
+  BlockDevices();
+
+  int SetDevices(const char *devices);
+
+  int Invalidate();
+
+  int Prefetch(ReadBatch &batch);
+
+  int Sample(struct s_io &io);
+
+  int SampleBurst(float &read, float &written);
+
+private:
+  enum Counters {
+    SectorsRead,
+    SectorsWritten,
+    Requests,
+    RequestTime,
+    BusyTime,
+    QueueTime,
+    NCounters
+  };
+
+  struct s_device {
+    std::string name;
+    unsigned long major, minor;
+    size_t row;
+    bool found, counted, burst_counted;
+    unsigned long long counters[NCounters], update[NCounters],
+        burst[SectorsWritten + 1];
+  };
+
+  int _discover();
+
+  int _add(const std::string &device);
+
+  int _read();
+
+  int _parse();
+
+  int _lookup(struct s_io &io, std::chrono::steady_clock::time_point now);
+
+  std::string _devices;
+
+  std::vector<struct s_device> _selected;
+
+  ProcFile _diskstats;
+
+  std::chrono::steady_clock::time_point _sampled, _burst_sampled;
+
+  bool _discovered;
+};
+
+inline int BlockDevices::SetDevices(const char *devices) {
+
+  _devices = std::string(devices);
+
+  return Invalidate();
+}
+
+inline int BlockDevices::Invalidate() {
+
+  _discovered = false;
+
+  return 0;
+}
+
+inline int BlockDevices::Prefetch(ReadBatch &batch) {
+
+  return batch.Add(_diskstats);
+}
+#endif // End of BLOCKDEVICES_H_
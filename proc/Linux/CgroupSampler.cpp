@@ -0,0 +1,469 @@
+/**
+ *  @file   CgroupSampler.cpp
+ *  @brief  Linux cgroup v2 Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "CgroupSampler.h"
+
+static const size_t MIN_BATCH = 64;
+
+static const uint32_t WATCH_MASK =
+    IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+CgroupSampler::CgroupSampler()
+    : _inotify_fd(inotify_init1(IN_CLOEXEC | IN_NONBLOCK)), _top(8),
+      _cursor(0), _alive(0), _discovered(false) {}
+
+CgroupSampler::~CgroupSampler() {
+
+  if (_inotify_fd >= 0) {
+
+    close(_inotify_fd);
+  }
+}
+
+int CgroupSampler::_discover() {
+
+  for (const struct s_node &node : _nodes) {
+
+    if (node.alive && node.wd >= 0) {
+
+      inotify_rm_watch(_inotify_fd, node.wd);
+    }
+  }
+
+  _nodes.clear();
+
+  _free.clear();
+
+  _watches.clear();
+
+  _paths.clear();
+
+  _tracked.clear();
+
+  _cursor = _alive = 0;
+
+  _discovered = true;
+
+  _root.clear();
+
+  // hybrid setups mount the v2 hierarchy next to the v1 controllers
+  const char *roots[] = {"/sys/fs/cgroup", "/sys/fs/cgroup/unified"};
+
+  for (const char *root : roots) {
+
+    if (access((std::string(root) + "/cgroup.controllers").c_str(), F_OK) ==
+        0) {
+
+      _root = std::string(root);
+
+      break;
+    }
+  }
+
+  if (_root.empty()) {
+
+    return 1;
+  }
+
+  _add(-1, "");
+
+  return 0;
+}
+
+// Watches the directory before listing it, so a cgroup created in between
+// is reported twice at worst; inotify hands out the same watch descriptor
+// for the same directory, which catches the duplicate.
+int CgroupSampler::_add(int parent, const std::string &path) {
+
+  std::string directory = _root + path;
+
+  int wd = inotify_add_watch(_inotify_fd, directory.c_str(), WATCH_MASK);
+
+  if (wd >= 0 && _watches.find(wd) != _watches.end()) {
+
+    return _watches[wd];
+  }
+
+  int node;
+
+  if (!_free.empty()) {
+
+    node = _free.back();
+
+    _free.pop_back();
+  } else {
+
+    node = _nodes.size();
+
+    _nodes.emplace_back();
+  }
+
+  _nodes[node] = {path, parent, 0, wd, 0, {}, 0.0f, true, false};
+
+  ++_alive;
+
+  if (parent >= 0) {
+
+    ++_nodes[parent].children;
+  }
+
+  if (wd >= 0) {
+
+    _watches[wd] = node;
+  }
+
+  _paths[path] = node;
+
+  DIR *dir = opendir(directory.c_str());
+
+  if (dir == nullptr) {
+
+    return node;
+  }
+
+  struct dirent *entry;
+
+  while ((entry = readdir(dir)) != nullptr) {
+
+    if (entry->d_type == DT_DIR && entry->d_name[0] != '.') {
+
+      _add(node, path + '/' + entry->d_name);
+    }
+  }
+
+  closedir(dir);
+
+  return node;
+}
+
+int CgroupSampler::_remove(int node) {
+
+  if (!_nodes[node].alive) {
+
+    return 1;
+  }
+
+  _nodes[node].alive = false;
+
+  --_alive;
+
+  if (_nodes[node].wd >= 0) {
+
+    inotify_rm_watch(_inotify_fd, _nodes[node].wd);
+
+    _watches.erase(_nodes[node].wd);
+  }
+
+  _paths.erase(_nodes[node].path);
+
+  if (_nodes[node].parent >= 0) {
+
+    --_nodes[_nodes[node].parent].children;
+  }
+
+  if (_nodes[node].tracked) {
+
+    _tracked.erase(
+        std::find_if(_tracked.begin(), _tracked.end(),
+                     [node](const std::unique_ptr<struct s_tracked> &tracked) {
+                       return tracked->node == node;
+                     }));
+  }
+
+  _free.push_back(node);
+
+  return 0;
+}
+
+// Drains the inotify queue. Cgroups are created and removed as directories
+// of their parent; a renamed one leaves stale paths behind, as does a queue
+// overflow, and both cause the tree to be walked again.
+int CgroupSampler::Update() {
+
+  alignas(struct inotify_event) char buffer[4096];
+
+  ssize_t n;
+
+  while ((n = read(_inotify_fd, buffer, sizeof(buffer))) > 0) {
+
+    const struct inotify_event *event;
+
+    for (char *p = buffer; p < buffer + n;
+         p += sizeof(struct inotify_event) + event->len) {
+
+      event = reinterpret_cast<const struct inotify_event *>(p);
+
+      if (event->mask & IN_Q_OVERFLOW) {
+
+        _discovered = false;
+
+        continue;
+      }
+
+      std::unordered_map<int, int>::iterator watch = _watches.find(event->wd);
+
+      if (watch == _watches.end()) {
+
+        continue;
+      }
+
+      int node = watch->second;
+
+      if ((event->mask & IN_DELETE) && (event->mask & IN_ISDIR)) {
+
+        std::unordered_map<std::string, int>::iterator child =
+            _paths.find(_nodes[node].path + '/' + event->name);
+
+        if (child != _paths.end()) {
+
+          _remove(child->second);
+        }
+      } else if (event->mask & (IN_MOVED_FROM | IN_MOVED_TO)) {
+
+        _discovered = false;
+      } else if ((event->mask & IN_CREATE) && (event->mask & IN_ISDIR)) {
+
+        // a first reading now lets the next visit rank the new cgroup
+        _visit(_add(node, _nodes[node].path + '/' + event->name),
+               std::chrono::steady_clock::now());
+      }
+    }
+  }
+
+  return 0;
+}
+
+unsigned long long CgroupSampler::_parse_usage(const char *data) {
+
+  const char *field = strstr(data, "usage_usec ");
+
+  return field == nullptr ? 0 : strtoull(field + 11, nullptr, 10);
+}
+
+// Sums the rbytes= and wbytes= fields of all devices in io.stat.
+unsigned long long CgroupSampler::_parse_bytes(const char *data) {
+
+  unsigned long long bytes = 0;
+
+  const char *field = data;
+
+  while ((field = strstr(field, "bytes=")) != nullptr) {
+
+    if (field > data && (*(field - 1) == 'r' || *(field - 1) == 'w')) {
+
+      bytes += strtoull(field + 6, nullptr, 10);
+    }
+
+    field += 6;
+  }
+
+  return bytes;
+}
+
+int CgroupSampler::_update(int node, unsigned long long usage,
+                           std::chrono::steady_clock::time_point now) {
+
+  struct s_node &cgroup = _nodes[node];
+
+  if (cgroup.visited.time_since_epoch().count() > 0 && now > cgroup.visited &&
+      usage >= cgroup.usage) {
+
+    cgroup.cpu =
+        static_cast<float>(usage - cgroup.usage) /
+        std::chrono::duration<float, std::micro>(now - cgroup.visited).count();
+  }
+
+  cgroup.usage = usage;
+
+  cgroup.visited = now;
+
+  return 0;
+}
+
+// Cgroups outside the top-N are read with a throw-away descriptor, keeping
+// one open for each of thousands of cgroups would exhaust the fd limit.
+int CgroupSampler::_visit(int node, std::chrono::steady_clock::time_point now) {
+
+  char buffer[1024];
+
+  int fd = open((_root + _nodes[node].path + "/cpu.stat").c_str(),
+                O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+
+    return 1;
+  }
+
+  ssize_t n = pread(fd, buffer, sizeof(buffer) - 1, 0);
+
+  close(fd);
+
+  if (n <= 0) {
+
+    return 1;
+  }
+
+  buffer[n] = '\0';
+
+  return _update(node, _parse_usage(buffer), now);
+}
+
+int CgroupSampler::Prefetch(ReadBatch &batch) {
+
+  for (std::unique_ptr<struct s_tracked> &tracked : _tracked) {
+
+    batch.Add(tracked->cpu);
+
+    batch.Add(tracked->memory);
+
+    batch.Add(tracked->io);
+  }
+
+  return 0;
+}
+
+int CgroupSampler::Sample(std::vector<struct s_cgroup> &cgroups) {
+
+  if (!_discovered && _discover() != 0) {
+
+    cgroups.clear();
+
+    return 1;
+  }
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  for (std::unique_ptr<struct s_tracked> &tracked : _tracked) {
+
+    if (tracked->cpu.Read() == 0) {
+
+      _update(tracked->node, _parse_usage(tracked->cpu.Data()), now);
+    }
+  }
+
+  // every leaf is visited at least once in eight calls
+  size_t batch = std::max(MIN_BATCH, (_alive + 7) / 8);
+
+  for (size_t n = 0; n < _nodes.size() && batch > 0; n++) {
+
+    _cursor = (_cursor + 1) % _nodes.size();
+
+    const struct s_node &node = _nodes[_cursor];
+
+    if (node.alive && !node.tracked && node.children == 0 &&
+        node.parent >= 0) {
+
+      _visit(_cursor, now);
+
+      --batch;
+    }
+  }
+
+  std::vector<int> leaves;
+
+  for (size_t n = 0; n < _nodes.size(); n++) {
+
+    const struct s_node &node = _nodes[n];
+
+    if (node.alive && node.children == 0 && node.parent >= 0 &&
+        node.cpu > 0.0f) {
+
+      leaves.push_back(n);
+    }
+  }
+
+  size_t top = std::min(_top, leaves.size());
+
+  std::partial_sort(leaves.begin(), leaves.begin() + top, leaves.end(),
+                    [this](int a, int b) {
+                      return _nodes[a].cpu > _nodes[b].cpu;
+                    });
+
+  leaves.resize(top);
+
+  _tracked.erase(
+      std::remove_if(_tracked.begin(), _tracked.end(),
+                     [&](const std::unique_ptr<struct s_tracked> &tracked) {
+                       bool keep = std::find(leaves.begin(), leaves.end(),
+                                             tracked->node) != leaves.end();
+
+                       _nodes[tracked->node].tracked = keep;
+
+                       return !keep;
+                     }),
+      _tracked.end());
+
+  for (int node : leaves) {
+
+    if (_nodes[node].tracked) {
+
+      continue;
+    }
+
+    std::unique_ptr<struct s_tracked> tracked =
+        std::make_unique<struct s_tracked>();
+
+    std::string directory = _root + _nodes[node].path;
+
+    tracked->node = node;
+
+    tracked->cpu.Open((directory + "/cpu.stat").c_str());
+
+    tracked->memory.Open((directory + "/memory.current").c_str());
+
+    tracked->io.Open((directory + "/io.stat").c_str());
+
+    tracked->bytes = 0;
+
+    tracked->read = {};
+
+    _nodes[node].tracked = true;
+
+    _tracked.push_back(std::move(tracked));
+  }
+
+  cgroups.clear();
+
+  for (std::unique_ptr<struct s_tracked> &tracked : _tracked) {
+
+    const struct s_node &node = _nodes[tracked->node];
+
+    struct s_cgroup cgroup = {node.path.substr(1), node.cpu, 0.0f, 0};
+
+    if (tracked->memory.Read() == 0) {
+
+      cgroup.memory = strtoul(tracked->memory.Data(), nullptr, 10);
+    }
+
+    if (tracked->io.Read() == 0) {
+
+      unsigned long long bytes = _parse_bytes(tracked->io.Data());
+
+      if (tracked->read.time_since_epoch().count() > 0 &&
+          now > tracked->read && bytes >= tracked->bytes) {
+
+        cgroup.io = static_cast<float>(bytes - tracked->bytes) /
+                    std::chrono::duration<float>(now - tracked->read).count();
+      }
+
+      tracked->bytes = bytes;
+
+      tracked->read = now;
+    }
+
+    cgroups.push_back(cgroup);
+  }
+
+  std::sort(cgroups.begin(), cgroups.end(),
+            [](const struct s_cgroup &a, const struct s_cgroup &b) {
+              return a.cpu > b.cpu;
+            });
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ *  @file   CgroupSampler.h
+ *  @brief  Linux cgroup v2 Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef CGROUPSAMPLER_H_
+#define CGROUPSAMPLER_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <memory>
+
+#include <string>
+
+#include <unordered_map>
+
+#include <vector>
+
+#include "ProcFile.h"
+#include "ReadBatch.h"
+
+// Ranks the leaf cgroups of the cgroup v2 hierarchy by CPU usage. The tree
+// is walked once and then kept current through inotify. Every Sample()
+// visits a slice of the cgroups in turn to find the busiest ones, while the
+// top-N keep their cpu.stat, memory.current and io.stat open and are
+// re-read in full on every call; Prefetch() queues those on a ReadBatch.
+class CgroupSampler {
+
+public:
+  struct s_cgroup {
+    std::string name;
+    float cpu, io;
+    unsigned long memory;
+  };
+
+  CgroupSampler();
+
+  ~CgroupSampler();
+
+  CgroupSampler(const CgroupSampler &) = delete;
+
+  CgroupSampler &operator=(const CgroupSampler &) = delete;
+
+  int SetTop(size_t top);
+
+  int GetFileDescriptor();
+
+  int Update();
+
+  int Prefetch(ReadBatch &batch);
+
+  int Sample(std::vector<struct s_cgroup> &cgroups);
+
+private:
+  struct s_node {
+    std::string path;
+    int parent, children, wd;
+    unsigned long long usage;
+    std::chrono::steady_clock::time_point visited;
+    float cpu;
+    bool alive, tracked;
+  };
+
+  struct s_tracked {
+    int node;
+    ProcFile cpu, memory, io;
+    unsigned long long bytes;
+    std::chrono::steady_clock::time_point read;
+  };
+
+  int _discover();
+
+  int _add(int parent, const std::string &path);
+
+  int _remove(int node);
+
+  int _visit(int node, std::chrono::steady_clock::time_point now);
+
+  int _update(int node, unsigned long long usage,
+              std::chrono::steady_clock::time_point now);
+
+  static unsigned long long _parse_usage(const char *data);
+
+  static unsigned long long _parse_bytes(const char *data);
+
+  std::string _root;
+
+  int _inotify_fd;
+
+  std::vector<struct s_node> _nodes;
+
+  std::vector<int> _free;
+
+  std::unordered_map<int, int> _watches;
+
+  std::unordered_map<std::string, int> _paths;
+
+  std::vector<std::unique_ptr<struct s_tracked>> _tracked;
+
+  size_t _top, _cursor, _alive;
+
+  bool _discovered;
+};
+
+inline int CgroupSampler::SetTop(size_t top) {
+
+  _top = top;
+
+  return 0;
+}
+
+inline int CgroupSampler::GetFileDescriptor() { return _inotify_fd; }
+#endif // End of CGROUPSAMPLER_H_
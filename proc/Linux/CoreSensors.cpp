@@ -0,0 +1,288 @@
+/**
+ *  @file   CoreSensors.cpp
+ *  @brief  Linux CPU Frequency and Temperature Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "CoreSensors.h"
+
+static const char *HWMON_CHIPS[] = {"coretemp", "k10temp", "zenpower"};
+
+// the number following prefix in name, when nothing else follows but suffix
+static bool numbered(const char *name, const char *prefix, const char *suffix,
+                     unsigned &number) {
+
+  size_t length = strlen(prefix);
+
+  if (strncmp(name, prefix, length) != 0 || name[length] < '0' ||
+      name[length] > '9') {
+
+    return false;
+  }
+
+  char *end;
+
+  number = strtoul(name + length, &end, 10);
+
+  return strcmp(end, suffix) == 0;
+}
+
+CoreSensors::CoreSensors(const char *root)
+    : _root(root), _discovered(false) {}
+
+CoreSensors::~CoreSensors() { _close(); }
+
+int CoreSensors::_close() {
+
+  for (std::vector<struct s_input> *inputs : {&_frequencies, &_temperatures}) {
+
+    for (const struct s_input &input : *inputs) {
+
+      close(input.fd);
+    }
+
+    inputs->clear();
+  }
+
+  return 0;
+}
+
+bool CoreSensors::_read(int fd, long &value) {
+
+  char buffer[32];
+
+  ssize_t n = pread(fd, buffer, sizeof(buffer) - 1, 0);
+
+  if (n <= 0) {
+
+    return false;
+  }
+
+  buffer[n] = '\0';
+
+  char *end;
+
+  value = strtol(buffer, &end, 10);
+
+  return end != buffer;
+}
+
+// Opens the input for good; its limit is read once and falls back when the
+// driver does not report one.
+int CoreSensors::_add(const std::string &input, const std::string &limit,
+                      long fallback, unsigned index,
+                      std::vector<struct s_input> &inputs) {
+
+  int fd = open(input.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+
+    return 1;
+  }
+
+  struct s_input entry = {index, fd, fallback};
+
+  int limit_fd = open(limit.c_str(), O_RDONLY | O_CLOEXEC);
+
+  long value;
+
+  if (limit_fd >= 0 && _read(limit_fd, value) && value > 0) {
+
+    entry.limit = value;
+  }
+
+  if (limit_fd >= 0) {
+
+    close(limit_fd);
+  }
+
+  inputs.push_back(entry);
+
+  return 0;
+}
+
+// "cpuN/cpufreq" is missing for offline cores, as the cores are in
+// /proc/stat; the input keeps N as its index.
+int CoreSensors::_discover_cpus() {
+
+  std::string cpus = _root + "/devices/system/cpu/";
+
+  DIR *dir = opendir(cpus.c_str());
+
+  if (dir == nullptr) {
+
+    return 1;
+  }
+
+  struct dirent *entry;
+
+  unsigned index;
+
+  while ((entry = readdir(dir)) != nullptr) {
+
+    if (!numbered(entry->d_name, "cpu", "", index)) {
+
+      continue;
+    }
+
+    std::string cpufreq = cpus + entry->d_name + "/cpufreq/";
+
+    _add(cpufreq + "scaling_cur_freq", cpufreq + "cpuinfo_max_freq", 0, index,
+         _frequencies);
+  }
+
+  closedir(dir);
+
+  return 0;
+}
+
+// Takes every tempN_input of the chips that sit on the CPU, ordered by chip
+// and then by input, which puts the package of coretemp before its cores.
+// Chips without tempN_crit are taken to be critical at 100 degrees.
+int CoreSensors::_discover_hwmon() {
+
+  std::string hwmon = _root + "/class/hwmon/";
+
+  DIR *dir = opendir(hwmon.c_str());
+
+  if (dir == nullptr) {
+
+    return 1;
+  }
+
+  struct dirent *entry;
+
+  unsigned chip_index, input_index;
+
+  while ((entry = readdir(dir)) != nullptr) {
+
+    if (!numbered(entry->d_name, "hwmon", "", chip_index)) {
+
+      continue;
+    }
+
+    std::string chip = hwmon + entry->d_name + '/';
+
+    char name[64] = {};
+
+    int fd = open((chip + "name").c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+
+      continue;
+    }
+
+    ssize_t n = read(fd, name, sizeof(name) - 1);
+
+    close(fd);
+
+    name[std::max<ssize_t>(n, 0)] = '\0';
+
+    name[strcspn(name, "\n")] = '\0';
+
+    if (std::find_if(std::begin(HWMON_CHIPS), std::end(HWMON_CHIPS),
+                     [&name](const char *cpu_chip) {
+                       return strcmp(name, cpu_chip) == 0;
+                     }) == std::end(HWMON_CHIPS) &&
+        strstr(name, "cpu") == nullptr) {
+
+      continue;
+    }
+
+    DIR *inputs = opendir(chip.c_str());
+
+    struct dirent *input;
+
+    while (inputs != nullptr && (input = readdir(inputs)) != nullptr) {
+
+      if (!numbered(input->d_name, "temp", "_input", input_index)) {
+
+        continue;
+      }
+
+      std::string prefix = chip + "temp" + std::to_string(input_index);
+
+      _add(prefix + "_input", prefix + "_crit", 100000,
+           chip_index << 16 | input_index, _temperatures);
+    }
+
+    if (inputs != nullptr) {
+
+      closedir(inputs);
+    }
+  }
+
+  closedir(dir);
+
+  return 0;
+}
+
+int CoreSensors::_discover() {
+
+  _close();
+
+  _discovered = true;
+
+  _discover_cpus();
+
+  _discover_hwmon();
+
+  for (std::vector<struct s_input> *inputs : {&_frequencies, &_temperatures}) {
+
+    std::sort(inputs->begin(), inputs->end(),
+              [](const struct s_input &a, const struct s_input &b) {
+                return a.index < b.index;
+              });
+  }
+
+  return 0;
+}
+
+// Reports the frequency of each core as a fraction of its maximum, indexed
+// by CPU number as the cores of /proc/stat are, the temperatures in degrees
+// Celsius, and as heat how close the hottest input is to its critical
+// temperature. An offline core, or one whose frequency cannot be read,
+// reads as 0; an input without a temperature is left out.
+int CoreSensors::Sample(struct s_sensors &sensors) {
+
+  if (!_discovered) {
+
+    _discover();
+  }
+
+  sensors.frequencies.assign(
+      _frequencies.empty() ? 0 : _frequencies.back().index + 1, 0.0f);
+
+  long value;
+
+  for (const struct s_input &input : _frequencies) {
+
+    if (_read(input.fd, value) && input.limit > 0) {
+
+      sensors.frequencies[input.index] =
+          static_cast<float>(value) / static_cast<float>(input.limit);
+    }
+  }
+
+  sensors.temperatures.clear();
+
+  sensors.heat = 0.0f;
+
+  for (const struct s_input &input : _temperatures) {
+
+    if (!_read(input.fd, value)) {
+
+      continue;
+    }
+
+    sensors.temperatures.push_back(1e-3f * value);
+
+    sensors.heat = std::max(sensors.heat, static_cast<float>(value) /
+                                              static_cast<float>(input.limit));
+  }
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ *  @file   CoreSensors.h
+ *  @brief  Linux CPU Frequency and Temperature Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef CORESENSORS_H_
+#define CORESENSORS_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <string>
+
+#include <vector>
+
+// Reads the current frequency of every core from cpufreq and the package
+// and core temperatures of the CPU's hwmon chips (coretemp, k10temp,
+// zenpower and the *cpu* thermal chips of ARM boards). The files are found
+// once and kept open, their limits (cpuinfo_max_freq, tempN_crit) are read
+// only then, and a sample is a single loop of pread(2)s over the
+// descriptors. Invalidate() redoes the discovery, e.g. after a CPU or hwmon
+// hotplug uevent.
+class CoreSensors {
+
+public:
+  struct s_sensors {
+    std::vector<float> frequencies, temperatures;
+    float heat;
+  };
+
+  CoreSensors(const char *root = "/sys");
+
+  ~CoreSensors();
+
+  CoreSensors(const CoreSensors &) = delete;
+
+  CoreSensors &operator=(const CoreSensors &) = delete;
+
+  int Invalidate();
+
+  int Sample(struct s_sensors &sensors);
+
+private:
+  struct s_input {
+    unsigned index;
+    int fd;
+    long limit;
+  };
+
+  int _discover();
+
+  int _discover_cpus();
+
+  int _discover_hwmon();
+
+  int _close();
+
+  static int _add(const std::string &input, const std::string &limit,
+                  long fallback, unsigned index,
+                  std::vector<struct s_input> &inputs);
+
+  static bool _read(int fd, long &value);
+
+  std::string _root;
+
+  std::vector<struct s_input> _frequencies, _temperatures;
+
+  bool _discovered;
+};
+
+inline int CoreSensors::Invalidate() {
+
+  _discovered = false;
+
+  return 0;
+}
+#endif // End of CORESENSORS_H_
@@ -0,0 +1,210 @@
+/**
+ *  @file   DefaultRoute.cpp
+ *  @brief  Linux Default Route Interface Tracker Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "DefaultRoute.h"
+
+DefaultRoute::DefaultRoute()
+    : _events_fd(socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                        NETLINK_ROUTE)),
+      _fd(socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)),
+      _seq(0) {
+
+  struct sockaddr_nl address = {};
+
+  address.nl_family = AF_NETLINK;
+
+  address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE;
+
+  if (_events_fd >= 0 &&
+      bind(_events_fd, reinterpret_cast<struct sockaddr *>(&address),
+           sizeof(address)) != 0) {
+
+    close(_events_fd);
+
+    _events_fd = -1;
+  }
+}
+
+DefaultRoute::~DefaultRoute() {
+
+  if (_events_fd >= 0) {
+
+    close(_events_fd);
+  }
+
+  if (_fd >= 0) {
+
+    close(_fd);
+  }
+}
+
+int DefaultRoute::Drain() {
+
+  char buffer[8192];
+
+  ssize_t n;
+
+  while (_events_fd >= 0 &&
+         ((n = recv(_events_fd, buffer, sizeof(buffer), 0)) > 0 ||
+          (n < 0 && (errno == EINTR || errno == ENOBUFS)))) {
+  }
+
+  return 0;
+}
+
+// The events only say that something changed, so the routes are looked up
+// afresh. A lost carrier, for one, removes IPv4 routes without a
+// notification of its own.
+int DefaultRoute::Update() {
+
+  int ifindex = 0;
+
+  uint32_t metric = UINT32_MAX;
+
+  if (_lookup(AF_INET, ifindex, metric) != 0 || ifindex == 0) {
+
+    _lookup(AF_INET6, ifindex, metric);
+  }
+
+  char name[IF_NAMESIZE];
+
+  // without a default route the last interface is kept
+  if (ifindex == 0 || if_indextoname(ifindex, name) == nullptr) {
+
+    return 1;
+  }
+
+  _interface = name;
+
+  return 0;
+}
+
+int DefaultRoute::_lookup(unsigned char family, int &ifindex,
+                          uint32_t &metric) {
+
+  if (_fd < 0) {
+
+    return 1;
+  }
+
+  struct {
+    struct nlmsghdr header;
+    struct rtmsg route;
+  } request = {};
+
+  request.header.nlmsg_len = NLMSG_LENGTH(sizeof(request.route));
+
+  request.header.nlmsg_type = RTM_GETROUTE;
+
+  request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+
+  request.header.nlmsg_seq = ++_seq;
+
+  request.route.rtm_family = family;
+
+  struct sockaddr_nl kernel = {};
+
+  kernel.nl_family = AF_NETLINK;
+
+  if (sendto(_fd, &request, request.header.nlmsg_len, 0,
+             reinterpret_cast<struct sockaddr *>(&kernel),
+             sizeof(kernel)) < 0) {
+
+    return 1;
+  }
+
+  alignas(struct nlmsghdr) char buffer[16384];
+
+  // every part of the dump is queued before the previous recv returns
+  while (true) {
+
+    ssize_t n = recv(_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+    if (n < 0) {
+
+      return 1;
+    }
+
+    int length = n;
+
+    for (struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer);
+         NLMSG_OK(header, length); header = NLMSG_NEXT(header, length)) {
+
+      if (header->nlmsg_seq != _seq) {
+
+        continue;
+      }
+
+      if (header->nlmsg_type == NLMSG_DONE) {
+
+        return 0;
+      }
+
+      if (header->nlmsg_type == NLMSG_ERROR) {
+
+        return 1;
+      }
+
+      struct rtmsg *route = static_cast<struct rtmsg *>(NLMSG_DATA(header));
+
+      if (header->nlmsg_type != RTM_NEWROUTE || route->rtm_dst_len != 0 ||
+          route->rtm_type != RTN_UNICAST ||
+          (route->rtm_flags & (RTNH_F_DEAD | RTNH_F_LINKDOWN))) {
+
+        continue;
+      }
+
+      uint32_t table = route->rtm_table, priority = 0;
+
+      int oif = 0;
+
+      int payload = RTM_PAYLOAD(header);
+
+      for (struct rtattr *rta = RTM_RTA(route); RTA_OK(rta, payload);
+           rta = RTA_NEXT(rta, payload)) {
+
+        if (rta->rta_type == RTA_TABLE) {
+
+          memcpy(&table, RTA_DATA(rta), sizeof(table));
+        } else if (rta->rta_type == RTA_OIF) {
+
+          memcpy(&oif, RTA_DATA(rta), sizeof(oif));
+        } else if (rta->rta_type == RTA_PRIORITY) {
+
+          memcpy(&priority, RTA_DATA(rta), sizeof(priority));
+        } else if (rta->rta_type == RTA_MULTIPATH &&
+                   RTA_PAYLOAD(rta) >= sizeof(struct rtnexthop)) {
+
+          // the first live nexthop stands in for the route
+          struct rtnexthop *nexthop =
+              static_cast<struct rtnexthop *>(RTA_DATA(rta));
+
+          int remaining = RTA_PAYLOAD(rta);
+
+          for (; RTNH_OK(nexthop, remaining) && oif == 0;
+               remaining -= RTNH_ALIGN(nexthop->rtnh_len),
+               nexthop = RTNH_NEXT(nexthop)) {
+
+            if (!(nexthop->rtnh_flags & (RTNH_F_DEAD | RTNH_F_LINKDOWN))) {
+
+              oif = nexthop->rtnh_ifindex;
+            }
+          }
+        }
+      }
+
+      if (table == RT_TABLE_MAIN && oif != 0 && priority < metric) {
+
+        ifindex = oif;
+
+        metric = priority;
+      }
+    }
+  }
+}
@@ -0,0 +1,63 @@
+/**
+ *  @file   DefaultRoute.h
+ *  @brief  Linux Default Route Interface Tracker Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef DEFAULTROUTE_H_
+#define DEFAULTROUTE_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+// Follows the interface that carries the default route. One NETLINK_ROUTE
+// socket listens to link and IPv4/IPv6 route changes and wakes the caller,
+// which drains it with Drain() and later calls Update() to look the routes
+// up again on a second socket. The IPv4 default route with the lowest
+// metric wins, then the IPv6 one. Routes whose link has lost carrier are
+// skipped.
+class DefaultRoute {
+
+public:
+  DefaultRoute();
+
+  ~DefaultRoute();
+
+  DefaultRoute(const DefaultRoute &) = delete;
+
+  DefaultRoute &operator=(const DefaultRoute &) = delete;
+
+  int GetFileDescriptor();
+
+  int Drain();
+
+  int Update();
+
+  const std::string &Interface();
+
+private:
+  int _lookup(unsigned char family, int &ifindex, uint32_t &metric);
+
+  int _events_fd, _fd;
+
+  uint32_t _seq;
+
+  std::string _interface;
+};
+
+inline int DefaultRoute::GetFileDescriptor() { return _events_fd; }
+
+inline const std::string &DefaultRoute::Interface() { return _interface; }
+#endif // End of DEFAULTROUTE_H_
@@ -0,0 +1,372 @@
+/**
+ *  @file   DiskSampler.cpp
+ *  @brief  Linux Asynchronous Filesystem Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "DiskSampler.h"
+
+static const size_t MAX_WORKERS = 8;
+
+DiskSampler::DiskSampler()
+    : _pool(std::make_shared<struct s_pool>()), _discovered(false),
+      _deadline(100) {
+
+  _mountinfo.Open("/proc/self/mountinfo", O_RDONLY, ProcFile::Layout::Table);
+}
+
+DiskSampler::~DiskSampler() {
+
+  // workers may be stuck in statfs on a hung mount, they hold on to the pool
+  // themselves and are detached, so there is nothing to join
+  std::lock_guard<std::mutex> lock(_pool->mutex);
+
+  _pool->terminate = true;
+
+  _pool->work.notify_all();
+}
+
+void DiskSampler::_worker_func(std::shared_ptr<struct s_pool> pool) {
+
+  std::unique_lock<std::mutex> lock(pool->mutex);
+
+  while (true) {
+
+    pool->work.wait(lock,
+                    [&] { return pool->terminate || !pool->queue.empty(); });
+
+    if (pool->terminate) {
+
+      break;
+    }
+
+    std::shared_ptr<struct s_job> job = pool->queue.front();
+
+    pool->queue.pop_front();
+
+    ++pool->busy;
+
+    bool resolve = job->resolve && job->resolved.empty();
+
+    lock.unlock();
+
+    // realpath(3) walks the path, and can hang on a mount as statfs(2) can
+    char buffer[PATH_MAX];
+
+    std::string resolved;
+
+    if (resolve && realpath(job->path.c_str(), buffer) != nullptr) {
+
+      resolved = buffer;
+    }
+
+    struct statfs result;
+
+    bool good = statfs(job->path.c_str(), &result) == 0;
+
+    lock.lock();
+
+    --pool->busy;
+
+    if (resolve) {
+
+      job->resolved = resolved;
+
+      job->missing = resolved.empty();
+    }
+
+    job->result = result;
+
+    job->good = good;
+
+    job->pending = false;
+
+    pool->done.notify_all();
+  }
+
+  --pool->threads;
+}
+
+int DiskSampler::_discover() {
+
+  if (_mountinfo.Read() != 0) {
+
+    return 1;
+  }
+
+  struct s_mount {
+    std::string point, type, source, device;
+  };
+
+  std::vector<struct s_mount> mounts;
+
+  const char *p = _mountinfo.Data();
+
+  while (*p != '\0') {
+
+    const char *eol = strchr(p, '\n');
+
+    if (eol == nullptr) {
+
+      eol = p + strlen(p);
+    }
+
+    std::vector<std::string> fields;
+
+    while (p < eol) {
+
+      std::string field;
+
+      while (p < eol && *p != ' ') {
+
+        // mount points escape blanks and backslashes as octal, e.g. \040
+        if (*p == '\\' && eol - p > 3) {
+
+          field += static_cast<char>(strtol(std::string(p + 1, 3).c_str(),
+                                            nullptr, 8));
+
+          p += 4;
+
+          continue;
+        }
+
+        field += *p++;
+      }
+
+      fields.push_back(field);
+
+      while (p < eol && *p == ' ') {
+
+        ++p;
+      }
+    }
+
+    p = *eol == '\n' ? eol + 1 : eol;
+
+    std::vector<std::string>::iterator separator =
+        std::find(fields.begin(), fields.end(), "-");
+
+    if (fields.size() < 5 || fields.end() - separator < 3) {
+
+      continue;
+    }
+
+    mounts.push_back({fields[4], *(separator + 1), *(separator + 2),
+                      fields[2]});
+  }
+
+  std::vector<std::string> targets, devices;
+
+  if (_paths == "*") {
+
+    for (const struct s_mount &mount : mounts) {
+
+      bool real = mount.type != "squashfs" &&
+                  (mount.source[0] == '/' ||
+                   mount.source.find(':') != std::string::npos ||
+                   mount.type.compare(0, 3, "nfs") == 0 ||
+                   mount.type == "cifs" || mount.type == "smb3");
+
+      // bind mounts show up once per mount point, sample the device once
+      if (real && std::find(devices.begin(), devices.end(), mount.device) ==
+                      devices.end()) {
+
+        targets.push_back(mount.point);
+
+        devices.push_back(mount.device);
+      }
+    }
+  } else {
+
+    std::string::size_type start = 0, end;
+
+    do {
+
+      end = _paths.find(',', start);
+
+      std::string path = _paths.substr(start, end - start);
+
+      start = end + 1;
+
+      if (!path.empty() &&
+          std::find(targets.begin(), targets.end(), path) == targets.end()) {
+
+        targets.push_back(path);
+      }
+    } while (end != std::string::npos);
+  }
+
+  _points.clear();
+
+  for (const struct s_mount &mount : mounts) {
+
+    _points.push_back(mount.point);
+  }
+
+  std::vector<std::shared_ptr<struct s_job>> jobs;
+
+  std::vector<struct s_disk> disks;
+
+  bool resolve = _paths != "*";
+
+  for (const std::string &target : targets) {
+
+    size_t n;
+
+    for (n = 0; n < _jobs.size() && _jobs[n]->path != target; n++)
+      ;
+
+    if (n < _jobs.size()) {
+
+      jobs.push_back(_jobs[n]);
+
+      disks.push_back(_disks[n]);
+
+      continue;
+    }
+
+    std::shared_ptr<struct s_job> job = std::make_shared<struct s_job>();
+
+    job->path = target;
+
+    job->resolve = resolve;
+
+    job->pending = job->good = job->missing = false;
+
+    jobs.push_back(job);
+
+    disks.push_back({target, 0, 0, 0, true});
+  }
+
+  _jobs.swap(jobs);
+
+  _disks.swap(disks);
+
+  // the mounts may have moved under the resolved paths
+  _named.assign(_jobs.size(), !resolve);
+
+  _discovered = true;
+
+  return 0;
+}
+
+// Returns the innermost mount point that holds file, or file itself.
+std::string DiskSampler::_mount_point(const std::string &file) {
+
+  std::string point;
+
+  for (const std::string &mount : _points) {
+
+    bool contains = file.compare(0, mount.size(), mount) == 0 &&
+                    (mount == "/" || file.size() == mount.size() ||
+                     file[mount.size()] == '/');
+
+    if (contains && mount.size() >= point.size()) {
+
+      point = mount;
+    }
+  }
+
+  return point.empty() ? file : point;
+}
+
+int DiskSampler::Sample(std::vector<struct s_disk> &disks) {
+
+  // the kernel flags the mount table with POLLPRI whenever it changes
+  struct pollfd pollfd = {_mountinfo.GetFileDescriptor(), POLLPRI, 0};
+
+  if (!_discovered ||
+      (poll(&pollfd, 1, 0) > 0 && (pollfd.revents & (POLLPRI | POLLERR)))) {
+
+    if (_discover() != 0) {
+
+      return 1;
+    }
+  }
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  std::vector<std::shared_ptr<struct s_job>> submitted;
+
+  std::unique_lock<std::mutex> lock(_pool->mutex);
+
+  for (std::shared_ptr<struct s_job> &job : _jobs) {
+
+    if (!job->pending) {
+
+      job->pending = true;
+
+      job->submitted = now;
+
+      _pool->queue.push_back(job);
+
+      submitted.push_back(job);
+    }
+  }
+
+  // calls stuck on a hung mount occupy their worker, add workers for the rest
+  while (_pool->threads - _pool->busy < _pool->queue.size() &&
+         _pool->threads < MAX_WORKERS) {
+
+    std::thread(&DiskSampler::_worker_func, _pool).detach();
+
+    ++_pool->threads;
+  }
+
+  _pool->work.notify_all();
+
+  _pool->done.wait_until(lock, now + _deadline, [&] {
+    return std::none_of(
+        submitted.begin(), submitted.end(),
+        [](const std::shared_ptr<struct s_job> &job) { return job->pending; });
+  });
+
+  for (size_t n = 0; n < _jobs.size(); n++) {
+
+    if (!_named[n] && !_jobs[n]->resolved.empty()) {
+
+      _disks[n].path = _mount_point(_jobs[n]->resolved);
+
+      _named[n] = true;
+    }
+
+    if (_jobs[n]->pending) {
+
+      _disks[n].stale = true;
+
+      continue;
+    }
+
+    _disks[n].stale = !_jobs[n]->good;
+
+    if (_jobs[n]->good) {
+
+      _disks[n].blocks = _jobs[n]->result.f_blocks;
+
+      _disks[n].bfree = _jobs[n]->result.f_bfree;
+
+      _disks[n].bavail = _jobs[n]->result.f_bavail;
+    }
+  }
+
+  disks.clear();
+
+  for (size_t n = 0; n < _disks.size(); n++) {
+
+    if (_jobs[n]->missing ||
+        std::any_of(disks.begin(), disks.end(),
+                    [&](const struct s_disk &disk) {
+                      return disk.path == _disks[n].path;
+                    })) {
+
+      continue;
+    }
+
+    disks.push_back(_disks[n]);
+  }
+
+  return 0;
+}
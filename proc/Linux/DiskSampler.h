@@ -0,0 +1,125 @@
+/**
+ *  @file   DiskSampler.h
+ *  @brief  Linux Asynchronous Filesystem Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef DISKSAMPLER_H_
+#define DISKSAMPLER_H_
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/statfs.h>
+
+#include <poll.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <condition_variable>
+
+#include <deque>
+
+#include <memory>
+
+#include <mutex>
+
+#include <string>
+
+#include <thread>
+
+#include <vector>
+
+#include "ProcFile.h"
+
+// Runs statfs(2) for a set of mounts on a small pool of worker threads. A
+// call that misses its deadline leaves the mount with its last good value,
+// marked stale, and the mount is not queried again until the call returns,
+// so a hung network filesystem costs the caller at most one deadline. The
+// paths given to SetPaths() are resolved with realpath(3) on the workers as
+// well, and named after the mount they turn out to be on; paths on the
+// same mount are reported once, paths that do not exist not at all.
+class DiskSampler {
+
+public:
+  struct s_disk {
+    std::string path;
+    unsigned long blocks, bfree, bavail;
+    bool stale;
+  };
+
+  DiskSampler();
+
+  ~DiskSampler();
+
+  int SetPaths(const char *paths);
+
+  int SetDeadline(int msec);
+
+  int Sample(std::vector<struct s_disk> &disks);
+
+private:
+  struct s_job {
+    std::string path, resolved;
+    struct statfs result;
+    bool resolve, pending, good, missing;
+    std::chrono::steady_clock::time_point submitted;
+  };
+
+  struct s_pool {
+    std::mutex mutex;
+    std::condition_variable work, done;
+    std::deque<std::shared_ptr<struct s_job>> queue;
+    size_t threads = 0, busy = 0;
+    bool terminate = false;
+  };
+
+  static void _worker_func(std::shared_ptr<struct s_pool> pool);
+
+  int _discover();
+
+  std::string _mount_point(const std::string &file);
+
+  std::shared_ptr<struct s_pool> _pool;
+
+  std::vector<std::shared_ptr<struct s_job>> _jobs;
+
+  std::vector<struct s_disk> _disks;
+
+  std::vector<bool> _named;
+
+  std::vector<std::string> _points;
+
+  ProcFile _mountinfo;
+
+  std::string _paths;
+
+  bool _discovered;
+
+  std::chrono::milliseconds _deadline;
+};
+
+inline int DiskSampler::SetPaths(const char *paths) {
+
+  _paths = std::string(paths);
+
+  _jobs.clear();
+
+  _discovered = false;
+
+  return 0;
+}
+
+inline int DiskSampler::SetDeadline(int msec) {
+
+  _deadline = std::chrono::milliseconds(msec);
+
+  return 0;
+}
+#endif // End of DISKSAMPLER_H_
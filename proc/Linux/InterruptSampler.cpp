@@ -0,0 +1,199 @@
+/**
+ *  @file   InterruptSampler.cpp
+ *  @brief  Linux Interrupt Distribution Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "InterruptSampler.h"
+
+// "24:", as opposed to the rows of the architecture (NMI, LOC, RES, ...)
+// that count timer ticks and inter-processor interrupts on every CPU
+static bool device_interrupt(const char *name, size_t length) {
+
+  return length > 0 && name[0] >= '0' && name[0] <= '9';
+}
+
+// the timer, scheduler and RCU softirqs run on every CPU alike and would
+// drown out the network
+static bool network_softirq(const char *name, size_t length) {
+
+  return length == 7 && (strncmp(name, "NET_RX:", 7) == 0 ||
+                         strncmp(name, "NET_TX:", 7) == 0);
+}
+
+InterruptSampler::InterruptSampler(const char *root)
+    : _fields(64), _lengths(64) {
+
+  _tables[0].file.Open((std::string(root) + "/interrupts").c_str(), O_RDONLY,
+                       ProcFile::Layout::Table);
+
+  _tables[0].select = device_interrupt;
+
+  _tables[1].file.Open((std::string(root) + "/softirqs").c_str());
+
+  _tables[1].select = network_softirq;
+}
+
+// The header names one column per online CPU: "CPU0 CPU1 CPU3 ..." when
+// CPU2 is offline. Each cell of a selected row is compared with that of
+// the row of the same name in the previous sample, and the moves are
+// summed per CPU; a row that is new, or that moved, only sets its
+// baseline. Rows are filtered on their name before the columns are split
+// off.
+int InterruptSampler::_parse(struct s_table &table) {
+
+  LineScanner scanner(table.file.Data(), table.file.Size());
+
+  if (!scanner.NextLine()) {
+
+    return 1;
+  }
+
+  size_t ncpus;
+
+  while ((ncpus = scanner.Fields(_fields.data(), _lengths.data(),
+                                 _fields.size())) == _fields.size()) {
+
+    _fields.resize(2 * _fields.size());
+
+    _lengths.resize(_fields.size());
+  }
+
+  if (_fields.size() < ncpus + 1) {
+
+    _fields.resize(ncpus + 1);
+
+    _lengths.resize(ncpus + 1);
+  }
+
+  _cpus.resize(ncpus);
+
+  size_t slots = 0;
+
+  for (size_t column = 0; column < ncpus; column++) {
+
+    if (_lengths[column] < 4 || strncmp(_fields[column], "CPU", 3) != 0) {
+
+      return 1;
+    }
+
+    _cpus[column] =
+        LineScanner::Decimal(_fields[column] + 3, _lengths[column] - 3);
+
+    slots = std::max(slots, _cpus[column] + 1);
+  }
+
+  // CPUs coming and going make a new baseline
+  if (table.cpus != _cpus) {
+
+    table.cpus = _cpus;
+
+    table.rows.clear();
+
+    table.counts.clear();
+  }
+
+  table.deltas.assign(slots, 0);
+
+  size_t row = 0;
+
+  while (scanner.NextLine()) {
+
+    if (scanner.Fields(_fields.data(), _lengths.data(), 1) != 1 ||
+        !table.select(_fields[0], _lengths[0]) ||
+        scanner.Fields(_fields.data(), _lengths.data(), ncpus + 1) !=
+            static_cast<int>(ncpus + 1)) {
+
+      continue;
+    }
+
+    bool known = row < table.rows.size() &&
+                 table.rows[row].size() == _lengths[0] &&
+                 memcmp(table.rows[row].data(), _fields[0], _lengths[0]) == 0;
+
+    if (!known) {
+
+      if (row >= table.rows.size()) {
+
+        table.rows.resize(row + 1);
+
+        table.counts.resize((row + 1) * ncpus);
+      }
+
+      table.rows[row].assign(_fields[0], _lengths[0]);
+    }
+
+    unsigned long long *counts = table.counts.data() + row * ncpus;
+
+    for (size_t column = 0; column < ncpus; column++) {
+
+      unsigned long long count =
+          LineScanner::Decimal(_fields[column + 1], _lengths[column + 1]);
+
+      if (known) {
+
+        table.deltas[table.cpus[column]] +=
+            counter_delta(count, counts[column]);
+      }
+
+      counts[column] = count;
+    }
+
+    row++;
+  }
+
+  table.rows.resize(row);
+
+  table.counts.resize(row * ncpus);
+
+  return 0;
+}
+
+// Turns the moves of the last parse into rates, by CPU number, with 0 for
+// a CPU that is offline.
+int InterruptSampler::_rates(struct s_table &table,
+                             std::vector<float> &rates) {
+
+  std::chrono::steady_clock::time_point read = table.file.ReadTime();
+
+  float elapsed = std::chrono::duration<float>(read - table.read).count();
+
+  rates.resize(table.deltas.size());
+
+  for (size_t cpu = 0; cpu < rates.size(); cpu++) {
+
+    rates[cpu] = elapsed > 0 ? table.deltas[cpu] / elapsed : 0.0f;
+  }
+
+  table.read = read;
+
+  return 0;
+}
+
+// Reports the device interrupts and network softirqs per second that each
+// CPU handled since the previous sample.
+int InterruptSampler::Sample(struct s_interrupts &interrupts) {
+
+  std::vector<float> *rates[] = {&interrupts.hardirqs, &interrupts.softirqs};
+
+  int error = 0;
+
+  for (int n = 0; n < 2; n++) {
+
+    if (_tables[n].file.Read() != 0 || _parse(_tables[n]) != 0) {
+
+      rates[n]->clear();
+
+      error = 1;
+
+      continue;
+    }
+
+    _rates(_tables[n], *rates[n]);
+  }
+
+  return error;
+}
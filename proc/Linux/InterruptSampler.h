@@ -0,0 +1,82 @@
+/**
+ *  @file   InterruptSampler.h
+ *  @brief  Linux Interrupt Distribution Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef INTERRUPTSAMPLER_H_
+#define INTERRUPTSAMPLER_H_
+
+#include <cstring>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <string>
+
+#include <vector>
+
+#include "Counter.h"
+#include "LineScanner.h"
+#include "ProcFile.h"
+#include "ReadBatch.h"
+
+// Follows how the device interrupts of /proc/interrupts and the network
+// softirqs of /proc/softirqs spread over the CPUs. Each table is walked
+// once with a LineScanner; every cell of the selected rows is compared
+// with its previous count, so a single 32-bit counter that wraps does not
+// spoil the sum, and the moves are summed per CPU. The columns belong to
+// the online CPUs only, and are mapped to CPU numbers from their "CPUn"
+// header. The arrays only grow when rows or CPUs come and go, so a sample
+// does not allocate. Prefetch() queues both files on a ReadBatch ahead of
+// Sample().
+class InterruptSampler {
+
+public:
+  struct s_interrupts {
+    std::vector<float> hardirqs, softirqs;
+  };
+
+  InterruptSampler(const char *root = "/proc");
+
+  int Prefetch(ReadBatch &batch);
+
+  int Sample(struct s_interrupts &interrupts);
+
+private:
+  struct s_table {
+    ProcFile file;
+    bool (*select)(const char *name, size_t length);
+    std::vector<size_t> cpus;
+    std::vector<std::string> rows;
+    std::vector<unsigned long long> counts, deltas;
+    std::chrono::steady_clock::time_point read;
+  };
+
+  int _parse(struct s_table &table);
+
+  int _rates(struct s_table &table, std::vector<float> &rates);
+
+  struct s_table _tables[2];
+
+  std::vector<const char *> _fields;
+
+  std::vector<size_t> _lengths;
+
+  std::vector<size_t> _cpus;
+};
+
+inline int InterruptSampler::Prefetch(ReadBatch &batch) {
+
+  for (struct s_table &table : _tables) {
+
+    batch.Add(table.file);
+  }
+
+  return 0;
+}
+#endif // End of INTERRUPTSAMPLER_H_
@@ -0,0 +1,387 @@
+/**
+ *  @file   LineScanner.cpp
+ *  @brief  Linux /proc Table Tokenizer Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "LineScanner.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LINESCANNER_X86
+#endif
+
+typedef const char *(*t_find_newline)(const char *p, const char *end);
+
+// a classifier marks the blanks and separators among 32 bytes
+typedef uint32_t (*t_classify)(const char *p, char separator);
+
+typedef const char *(*t_find)(const char *p, const char *end,
+                              const char *name, size_t length);
+
+static const char *find_newline_scalar(const char *p, const char *end) {
+
+  while (p < end && *p != '\n') {
+
+    ++p;
+  }
+
+  return p;
+}
+
+static const char *find_scalar(const char *p, const char *end,
+                               const char *name, size_t length) {
+
+  return static_cast<const char *>(memmem(p, end - p, name, length));
+}
+
+static uint32_t classify_scalar(const char *p, size_t length,
+                                char separator) {
+
+  uint32_t mask = 0;
+
+  for (size_t i = 0; i < length; i++) {
+
+    if (p[i] == ' ' || p[i] == '\t' || p[i] == separator) {
+
+      mask |= 1U << i;
+    }
+  }
+
+  return mask;
+}
+
+static uint32_t classify_scalar32(const char *p, char separator) {
+
+  return classify_scalar(p, 32, separator);
+}
+
+#ifdef LINESCANNER_X86
+__attribute__((target("sse2"))) static const char *
+find_newline_sse2(const char *p, const char *end) {
+
+  const __m128i newline = _mm_set1_epi8('\n');
+
+  for (; end - p >= 16; p += 16) {
+
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), newline));
+
+    if (mask != 0) {
+
+      return p + __builtin_ctz(mask);
+    }
+  }
+
+  return find_newline_scalar(p, end);
+}
+
+__attribute__((target("sse2"))) static uint32_t
+classify_sse2(const char *p, char separator) {
+
+  const __m128i blank = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'),
+                other = _mm_set1_epi8(separator);
+
+  uint32_t mask = 0;
+
+  for (int half = 0; half < 2; half++) {
+
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * half));
+
+    __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, blank), _mm_cmpeq_epi8(bytes, tab)),
+        _mm_cmpeq_epi8(bytes, other));
+
+    mask |= static_cast<uint32_t>(_mm_movemask_epi8(hits)) << (16 * half);
+  }
+
+  return mask;
+}
+
+// Candidates are where both the first and the last byte of name match,
+// 16 positions at a time; only those are compared in full.
+__attribute__((target("sse2"))) static const char *
+find_sse2(const char *p, const char *end, const char *name, size_t length) {
+
+  const __m128i first = _mm_set1_epi8(name[0]),
+                last = _mm_set1_epi8(name[length - 1]);
+
+  for (; end - p >= static_cast<ptrdiff_t>(length + 15); p += 16) {
+
+    __m128i heads = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)),
+            tails = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(p + length - 1));
+
+    uint32_t mask = _mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(heads, first), _mm_cmpeq_epi8(tails, last)));
+
+    for (; mask != 0; mask &= mask - 1) {
+
+      const char *candidate = p + __builtin_ctz(mask);
+
+      if (memcmp(candidate, name, length) == 0) {
+
+        return candidate;
+      }
+    }
+  }
+
+  return find_scalar(p, end, name, length);
+}
+
+__attribute__((target("avx2"))) static const char *
+find_newline_avx2(const char *p, const char *end) {
+
+  const __m256i newline = _mm256_set1_epi8('\n');
+
+  for (; end - p >= 32; p += 32) {
+
+    uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)), newline));
+
+    if (mask != 0) {
+
+      return p + __builtin_ctz(mask);
+    }
+  }
+
+  return find_newline_sse2(p, end);
+}
+
+__attribute__((target("avx2"))) static uint32_t
+classify_avx2(const char *p, char separator) {
+
+  __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+
+  __m256i hits = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                      _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+      _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(separator)));
+
+  return _mm256_movemask_epi8(hits);
+}
+
+// As find_sse2(), 64 positions at a time.
+__attribute__((target("avx2"))) static const char *
+find_avx2(const char *p, const char *end, const char *name, size_t length) {
+
+  const __m256i first = _mm256_set1_epi8(name[0]),
+                last = _mm256_set1_epi8(name[length - 1]);
+
+  for (; end - p >= static_cast<ptrdiff_t>(length + 63); p += 64) {
+
+    uint64_t mask = 0;
+
+    for (int half = 0; half < 2; half++) {
+
+      const char *q = p + 32 * half;
+
+      __m256i heads = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(q)),
+              tails = _mm256_loadu_si256(
+                  reinterpret_cast<const __m256i *>(q + length - 1));
+
+      mask |= static_cast<uint64_t>(static_cast<uint32_t>(
+                  _mm256_movemask_epi8(_mm256_and_si256(
+                      _mm256_cmpeq_epi8(heads, first),
+                      _mm256_cmpeq_epi8(tails, last)))))
+              << (32 * half);
+    }
+
+    for (; mask != 0; mask &= mask - 1) {
+
+      const char *candidate = p + __builtin_ctzll(mask);
+
+      if (memcmp(candidate, name, length) == 0) {
+
+        return candidate;
+      }
+    }
+  }
+
+  return find_sse2(p, end, name, length);
+}
+
+#endif
+
+static struct s_dispatch {
+  t_find_newline find_newline;
+  t_classify classify;
+  t_find find;
+} dispatch = [] {
+#ifdef LINESCANNER_X86
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+
+    return s_dispatch{find_newline_avx2, classify_avx2, find_avx2};
+  }
+
+  if (__builtin_cpu_supports("sse2")) {
+
+    return s_dispatch{find_newline_sse2, classify_sse2, find_sse2};
+  }
+#endif
+  return s_dispatch{find_newline_scalar, classify_scalar32, find_scalar};
+}();
+
+LineScanner::LineScanner(const char *data, size_t size, char separator)
+    : _p(data), _end(data + size), _line(data), _eol(data),
+      _separator(separator) {}
+
+bool LineScanner::NextLine() {
+
+  if (_p >= _end) {
+
+    return false;
+  }
+
+  _line = _p;
+
+  _eol = dispatch.find_newline(_p, _end);
+
+  _p = _eol < _end ? _eol + 1 : _end;
+
+  return true;
+}
+
+// Moves on to the next line whose field-th field (at most the 16th) is
+// name. The name is searched for in bulk, which outpaces splitting every
+// row by far, and a line is only split to check that the match is the
+// whole field, and the right one.
+bool LineScanner::FindLine(const char *name, size_t length, int field) {
+
+  const char *fields[16];
+
+  size_t lengths[16];
+
+  for (const char *p = _p;
+       length > 0 && field < 16 &&
+       (p = dispatch.find(p, _end, name, length)) != nullptr;
+       p++) {
+
+    const char *newline =
+        static_cast<const char *>(memrchr(_p, '\n', p - _p));
+
+    _line = newline != nullptr ? newline + 1 : _p;
+
+    _eol = dispatch.find_newline(p, _end);
+
+    if (Fields(fields, lengths, field + 1) == field + 1 && fields[field] == p &&
+        lengths[field] == length) {
+
+      _p = _eol < _end ? _eol + 1 : _end;
+
+      return true;
+    }
+  }
+
+  _line = _eol = _p = _end;
+
+  return false;
+}
+
+// Field starts are the non-delimiters that follow a delimiter, field ends
+// the delimiters that follow a field, both found with bit scans over the
+// delimiter mask of each 32 byte block of the line.
+int LineScanner::Fields(const char **fields, size_t *lengths, int max) {
+
+  const char *start = nullptr;
+
+  int n = 0;
+
+  for (const char *p = _line; p < _eol && n < max; p += 32) {
+
+    size_t length = _eol - p;
+
+    uint32_t delimiters =
+        length >= 32 ? dispatch.classify(p, _separator)
+                     : classify_scalar(p, length, _separator) | (~0U << length);
+
+    int i = 0;
+
+    while (i < 32) {
+
+      uint32_t bits =
+          (start == nullptr ? ~delimiters : delimiters) & (~0U << i);
+
+      if (bits == 0) {
+
+        break;
+      }
+
+      i = __builtin_ctz(bits);
+
+      if (start == nullptr) {
+
+        start = p + i;
+
+        continue;
+      }
+
+      fields[n] = start;
+
+      lengths[n] = p + i - start;
+
+      start = nullptr;
+
+      if (++n == max) {
+
+        return n;
+      }
+    }
+  }
+
+  if (start != nullptr) {
+
+    fields[n] = start;
+
+    lengths[n++] = _eol - start;
+  }
+
+  return n;
+}
+
+// Eight digits at a time: subtract '0' from every byte, then combine
+// neighbouring digits, pairs and quads with a multiply and shift each.
+unsigned long long LineScanner::Decimal(const char *p, size_t length) {
+
+  unsigned long long value = 0;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; length >= 8; p += 8, length -= 8) {
+
+    uint64_t chunk;
+
+    memcpy(&chunk, p, 8);
+
+    // every byte must be in '0'..'9'
+    if (((chunk & 0xf0f0f0f0f0f0f0f0ULL) |
+         (((chunk + 0x0606060606060606ULL) & 0xf0f0f0f0f0f0f0f0ULL) >> 4)) !=
+        0x3333333333333333ULL) {
+
+      break;
+    }
+
+    chunk -= 0x3030303030303030ULL;
+
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00ff00ff00ff00ffULL;
+
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000ffff0000ffffULL;
+
+    chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000ffffffffULL;
+
+    value = value * 100000000ULL + chunk;
+  }
+#endif
+
+  for (; length > 0 && *p >= '0' && *p <= '9'; ++p, --length) {
+
+    value = value * 10 + (*p - '0');
+  }
+
+  return value;
+}
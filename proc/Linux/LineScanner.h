@@ -0,0 +1,44 @@
+/**
+ *  @file   LineScanner.h
+ *  @brief  Linux /proc Table Tokenizer Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef LINESCANNER_H_
+#define LINESCANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Splits a /proc table into lines and blank separated fields. Newlines and
+// field boundaries are located 32 (AVX2) or 16 (SSE2) bytes at a time when
+// the CPU supports it, with a scalar fallback otherwise. FindLine() skips
+// ahead to the row of a name with memmem(3), so that only the rows that
+// contain the name are split up.
+class LineScanner {
+
+public:
+  LineScanner(const char *data, size_t size, char separator = ' ');
+
+  bool NextLine();
+
+  bool FindLine(const char *name, size_t length, int field);
+
+  const char *Line();
+
+  int Fields(const char **fields, size_t *lengths, int max);
+
+  static unsigned long long Decimal(const char *p, size_t length);
+
+private:
+  const char *_p, *_end, *_line, *_eol;
+
+  char _separator;
+};
+
+inline const char *LineScanner::Line() { return _line; }
+#endif // End of LINESCANNER_H_
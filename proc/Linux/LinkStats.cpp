@@ -0,0 +1,193 @@
+/**
+ *  @file   LinkStats.cpp
+ *  @brief  Linux rtnetlink Interface Counter Reader Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "LinkStats.h"
+
+LinkStats::LinkStats()
+    : _fd(socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)),
+      _ifindex(0), _type(RTM_GETSTATS), _seq(0) {}
+
+LinkStats::~LinkStats() {
+
+  if (_fd >= 0) {
+
+    close(_fd);
+  }
+}
+
+int LinkStats::SetInterface(const std::string &name) {
+
+  _name = name;
+
+  _ifindex = 0;
+
+  return 0;
+}
+
+int LinkStats::Sample(unsigned long long &received, unsigned long long &sent) {
+
+  if (_fd < 0 || _type == 0) {
+
+    return 1;
+  }
+
+  if (_ifindex == 0 && (_ifindex = if_nametoindex(_name.c_str())) == 0) {
+
+    return 1;
+  }
+
+  int error = _request(received, sent);
+
+  if (error == EOPNOTSUPP || error == EINVAL) {
+
+    // RTM_GETSTATS is unknown to this kernel, try RTM_GETLINK once
+    _type = _type == RTM_GETSTATS ? RTM_GETLINK : 0;
+
+    error = _type != 0 ? _request(received, sent) : error;
+
+    if (error == EOPNOTSUPP || error == EINVAL) {
+
+      _type = 0;
+    }
+  }
+
+  if (error == ENODEV) {
+
+    // the interface was removed, or recreated under the same name
+    _ifindex = 0;
+  }
+
+  return error == 0 ? 0 : 1;
+}
+
+// Returns 0 or the errno of the failed request.
+int LinkStats::_request(unsigned long long &received,
+                        unsigned long long &sent) {
+
+  struct {
+    struct nlmsghdr header;
+    union {
+      struct if_stats_msg stats;
+      struct ifinfomsg link;
+    };
+  } request = {};
+
+  request.header.nlmsg_len = NLMSG_LENGTH(
+      _type == RTM_GETSTATS ? sizeof(request.stats) : sizeof(request.link));
+
+  request.header.nlmsg_type = _type;
+
+  request.header.nlmsg_flags = NLM_F_REQUEST;
+
+  request.header.nlmsg_seq = ++_seq;
+
+  if (_type == RTM_GETSTATS) {
+
+    request.stats.family = AF_UNSPEC;
+
+    request.stats.ifindex = _ifindex;
+
+    request.stats.filter_mask = IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64);
+  } else {
+
+    request.link.ifi_family = AF_UNSPEC;
+
+    request.link.ifi_index = _ifindex;
+  }
+
+  struct sockaddr_nl kernel = {};
+
+  kernel.nl_family = AF_NETLINK;
+
+  if (sendto(_fd, &request, request.header.nlmsg_len, 0,
+             reinterpret_cast<struct sockaddr *>(&kernel),
+             sizeof(kernel)) < 0) {
+
+    return errno;
+  }
+
+  alignas(struct nlmsghdr) char buffer[16384];
+
+  // rtnetlink answers from within sendto(), so the reply is already queued
+  // and an earlier, abandoned reply is skipped on its sequence number
+  while (true) {
+
+    ssize_t n = recv(_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+    if (n < 0) {
+
+      return errno;
+    }
+
+    int length = n;
+
+    for (struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer);
+         NLMSG_OK(header, length); header = NLMSG_NEXT(header, length)) {
+
+      if (header->nlmsg_seq != _seq) {
+
+        continue;
+      }
+
+      struct rtattr *attribute = nullptr;
+
+      if (header->nlmsg_type == NLMSG_ERROR) {
+
+        int error = -static_cast<struct nlmsgerr *>(NLMSG_DATA(header))->error;
+
+        return error != 0 ? error : ENODATA;
+      } else if (header->nlmsg_type == RTM_NEWSTATS) {
+
+        struct if_stats_msg *stats =
+            static_cast<struct if_stats_msg *>(NLMSG_DATA(header));
+
+        attribute = _find_attribute(
+            reinterpret_cast<struct rtattr *>(
+                reinterpret_cast<char *>(stats) + NLMSG_ALIGN(sizeof(*stats))),
+            header->nlmsg_len - NLMSG_LENGTH(sizeof(*stats)),
+            IFLA_STATS_LINK_64);
+      } else if (header->nlmsg_type == RTM_NEWLINK) {
+
+        attribute = _find_attribute(
+            IFLA_RTA(static_cast<struct ifinfomsg *>(NLMSG_DATA(header))),
+            IFLA_PAYLOAD(header), IFLA_STATS64);
+      }
+
+      if (attribute == nullptr ||
+          RTA_PAYLOAD(attribute) < sizeof(struct rtnl_link_stats64)) {
+
+        return ENODATA;
+      }
+
+      struct rtnl_link_stats64 stats;
+
+      memcpy(&stats, RTA_DATA(attribute), sizeof(stats));
+
+      received = stats.rx_bytes;
+
+      sent = stats.tx_bytes;
+
+      return 0;
+    }
+  }
+}
+
+struct rtattr *LinkStats::_find_attribute(struct rtattr *rta, int length,
+                                          unsigned short type) {
+
+  for (; RTA_OK(rta, length); rta = RTA_NEXT(rta, length)) {
+
+    if (rta->rta_type == type) {
+
+      return rta;
+    }
+  }
+
+  return nullptr;
+}
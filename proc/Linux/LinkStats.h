@@ -0,0 +1,61 @@
+/**
+ *  @file   LinkStats.h
+ *  @brief  Linux rtnetlink Interface Counter Reader Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef LINKSTATS_H_
+#define LINKSTATS_H_
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+
+// Reads the 64-bit byte counters of a network interface over a
+// NETLINK_ROUTE socket, one binary request and reply per sample. Kernels
+// before 4.7 lack RTM_GETSTATS, in which case the IFLA_STATS64 attribute of
+// RTM_GETLINK is used. Sample() fails when neither is available, leaving
+// the caller to fall back to /proc/net/dev.
+class LinkStats {
+
+public:
+  LinkStats();
+
+  ~LinkStats();
+
+  LinkStats(const LinkStats &) = delete;
+
+  LinkStats &operator=(const LinkStats &) = delete;
+
+  int SetInterface(const std::string &name);
+
+  int Sample(unsigned long long &received, unsigned long long &sent);
+
+private:
+  int _request(unsigned long long &received, unsigned long long &sent);
+
+  static struct rtattr *_find_attribute(struct rtattr *rta, int length,
+                                        unsigned short type);
+
+  std::string _name;
+
+  int _fd;
+
+  unsigned int _ifindex;
+
+  uint16_t _type;
+
+  uint32_t _seq;
+};
+#endif // End of LINKSTATS_H_
@@ -0,0 +1,261 @@
+/**
+ *  @file   PerfCounters.cpp
+ *  @brief  Linux System-wide perf_event Counter Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "PerfCounters.h"
+
+static const uint64_t SOFTWARE[] = {PERF_COUNT_SW_CONTEXT_SWITCHES,
+                                    PERF_COUNT_SW_PAGE_FAULTS,
+                                    PERF_COUNT_SW_CPU_MIGRATIONS};
+
+static const uint64_t HARDWARE[] = {PERF_COUNT_HW_CPU_CYCLES,
+                                    PERF_COUNT_HW_INSTRUCTIONS};
+
+static int perf_event_open(struct perf_event_attr *attr, pid_t pid, int cpu,
+                           int group_fd, unsigned long flags) {
+
+  return syscall(SYS_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+PerfCounters::PerfCounters() : _opened(false) {
+
+  std::fill(std::begin(_counters), std::end(_counters), 0);
+}
+
+PerfCounters::~PerfCounters() { _close(); }
+
+int PerfCounters::_close() {
+
+  for (std::vector<int> *fds : {&_software, &_hardware}) {
+
+    for (int fd : *fds) {
+
+      close(fd);
+    }
+
+    fds->clear();
+  }
+
+  return 0;
+}
+
+// Opens one group of n events counting pid on cpu and appends it to fds.
+// Counting only the own processes (pid 0, inherited by children) leaves
+// the kernel out, as perf_event_paranoid 2 demands. Returns 0, or the
+// errno of the open that failed, in which case none of the group is kept.
+static int open_group(uint32_t type, const uint64_t *configs, int n,
+                      pid_t pid, int cpu, std::vector<int> &fds) {
+
+  size_t first = fds.size();
+
+  int leader = -1;
+
+  for (int i = 0; i < n; i++) {
+
+    struct perf_event_attr attr = {};
+
+    attr.size = sizeof(attr);
+
+    attr.type = type;
+
+    attr.config = configs[i];
+
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    if (pid == 0) {
+
+      attr.inherit = 1;
+
+      attr.exclude_kernel = 1;
+
+      attr.exclude_hv = 1;
+    }
+
+    int fd = perf_event_open(&attr, pid, cpu, leader, PERF_FLAG_FD_CLOEXEC);
+
+    if (fd < 0) {
+
+      int error = errno;
+
+      for (size_t k = first; k < fds.size(); k++) {
+
+        close(fds[k]);
+      }
+
+      fds.resize(first);
+
+      return error;
+    }
+
+    fds.push_back(fd);
+
+    leader = i == 0 ? fd : leader;
+  }
+
+  return 0;
+}
+
+// Opens a group of n events on every CPU, counting all processes on it;
+// a CPU that is offline is skipped. On any other failure none of the
+// groups is kept: a sum over only some CPUs would be misleading. Without
+// the privilege to count the whole system, a single group counts this
+// process and the ones it starts instead.
+int PerfCounters::_open_groups(uint32_t type, const uint64_t *configs, int n,
+                               std::vector<int> &fds) {
+
+  long ncpus = sysconf(_SC_NPROCESSORS_CONF);
+
+  for (int cpu = 0; cpu < ncpus; cpu++) {
+
+    int error = open_group(type, configs, n, -1, cpu, fds);
+
+    if (error == 0 || error == ENODEV) {
+
+      continue;
+    }
+
+    for (int opened : fds) {
+
+      close(opened);
+    }
+
+    fds.clear();
+
+    if (error == EACCES || error == EPERM) {
+
+      return open_group(type, configs, n, 0, -1, fds) == 0 ? 0 : 1;
+    }
+
+    return 1;
+  }
+
+  return fds.empty() ? 1 : 0;
+}
+
+// One read(2) per group hands out { nr, values[nr] }. The sums over the
+// groups only reach values when every group read.
+int PerfCounters::_read_groups(const std::vector<int> &fds, int n,
+                               unsigned long long *values) {
+
+  uint64_t group[1 + NCounters];
+
+  unsigned long long sums[NCounters] = {};
+
+  for (size_t leader = 0; leader < fds.size(); leader += n) {
+
+    ssize_t size = read(fds[leader], group, (1 + n) * sizeof(uint64_t));
+
+    if (size != static_cast<ssize_t>((1 + n) * sizeof(uint64_t)) ||
+        group[0] != static_cast<uint64_t>(n)) {
+
+      return 1;
+    }
+
+    for (int i = 0; i < n; i++) {
+
+      sums[i] += group[1 + i];
+    }
+  }
+
+  std::copy(sums, sums + n, values);
+
+  return 0;
+}
+
+int PerfCounters::_open() {
+
+  _close();
+
+  _opened = true;
+
+  _software_read = _hardware_read = {};
+
+  _open_groups(PERF_TYPE_SOFTWARE, SOFTWARE, 3, _software);
+
+  _open_groups(PERF_TYPE_HARDWARE, HARDWARE, 2, _hardware);
+
+  return _software.empty() && _hardware.empty() ? 1 : 0;
+}
+
+// Reports the events per second over all CPUs since the previous sample,
+// and the instructions per cycle. A busy PMU may time-share the hardware
+// groups, but cycles and instructions are always counted together, so
+// their ratio holds even when the counts themselves fall short.
+int PerfCounters::Sample(struct s_perf &perf) {
+
+  if (!_opened) {
+
+    _open();
+  }
+
+  perf = {};
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  unsigned long long values[NCounters] = {};
+
+  perf.software = !_software.empty() &&
+                  _read_groups(_software, 3, values + Switches) == 0;
+
+  perf.hardware = !_hardware.empty() &&
+                  _read_groups(_hardware, 2, values + Cycles) == 0;
+
+  if (!perf.software && !perf.hardware) {
+
+    return 1;
+  }
+
+  float elapsed = std::chrono::duration<float>(now - _software_read).count();
+
+  bool software = _software_read.time_since_epoch().count() > 0 && elapsed > 0;
+
+  bool hardware = _hardware_read.time_since_epoch().count() > 0;
+
+  unsigned long long delta[NCounters];
+
+  // a kind that failed to read keeps its counters, and the time they were
+  // read, for the next sample
+  for (int n = 0; n < NCounters; n++) {
+
+    if (n < Cycles ? !perf.software : !perf.hardware) {
+
+      continue;
+    }
+
+    delta[n] = counter_delta(values[n], _counters[n]);
+
+    _counters[n] = values[n];
+  }
+
+  if (perf.software) {
+
+    _software_read = now;
+  }
+
+  if (perf.hardware) {
+
+    _hardware_read = now;
+  }
+
+  if (software && perf.software) {
+
+    perf.switches = delta[Switches] / elapsed;
+
+    perf.faults = delta[Faults] / elapsed;
+
+    perf.migrations = delta[Migrations] / elapsed;
+  }
+
+  if (hardware && perf.hardware && delta[Cycles] > 0) {
+
+    perf.ipc = static_cast<float>(delta[Instructions]) /
+               static_cast<float>(delta[Cycles]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ *  @file   PerfCounters.h
+ *  @brief  Linux System-wide perf_event Counter Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <vector>
+
+#include "Counter.h"
+
+// Counts context switches, page faults and CPU migrations, and where the CPU
+// has a PMU cycles and instructions, on every CPU through perf_event_open(2).
+// The events of a kind form one group per CPU, read with PERF_FORMAT_GROUP in
+// one read(2). Counting all CPUs takes CAP_PERFMON or
+// kernel.perf_event_paranoid <= 0; without it the events fall back to a single
+// group that counts bPulse and the processes it starts, in user space only, as
+// the default paranoia of 2 allows any user to; context switches and migrations
+// happen in the kernel and read 0 there. Without a PMU, as in most VMs, the
+// hardware events are reported as missing rather than failing the sample.
+// Invalidate() reopens the groups, e.g. after a CPU hotplug uevent.
+class PerfCounters {
+
+public:
+  struct s_perf {
+    float switches, faults, migrations, ipc;
+    bool software, hardware;
+  };
+
+  PerfCounters();
+
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  int Invalidate();
+
+  int Sample(struct s_perf &perf);
+
+private:
+  enum Counters {
+    Switches,
+    Faults,
+    Migrations,
+    Cycles,
+    Instructions,
+    NCounters
+  };
+
+  int _open();
+
+  int _close();
+
+  static int _open_groups(uint32_t type, const uint64_t *configs, int n,
+                          std::vector<int> &fds);
+
+  static int _read_groups(const std::vector<int> &fds, int n,
+                          unsigned long long *values);
+
+  // the groups one after the other, each leader followed by its members
+  std::vector<int> _software, _hardware;
+
+  unsigned long long _counters[NCounters];
+
+  std::chrono::steady_clock::time_point _software_read, _hardware_read;
+
+  bool _opened;
+};
+
+inline int PerfCounters::Invalidate() {
+
+  _opened = false;
+
+  return 0;
+}
+#endif // End of PERFCOUNTERS_H_
@@ -0,0 +1,234 @@
+/**
+ *  @file   PowerSupply.cpp
+ *  @brief  Linux Power Supply Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "PowerSupply.h"
+
+static const char *POWER_SUPPLY = "/sys/class/power_supply/";
+
+static std::unique_ptr<ProcFile> open_attribute(const std::string &device,
+                                                const char *attribute) {
+
+  std::unique_ptr<ProcFile> file = std::make_unique<ProcFile>();
+
+  if (file->Open((device + attribute).c_str()) != 0) {
+
+    return nullptr;
+  }
+
+  return file;
+}
+
+PowerSupply::PowerSupply() : _discovered(false) {}
+
+int PowerSupply::_discover() {
+
+  _batteries.clear();
+
+  _adapters.clear();
+
+  _discovered = true;
+
+  DIR *dir = opendir(POWER_SUPPLY);
+
+  if (dir == nullptr) {
+
+    return 1;
+  }
+
+  struct dirent *entry;
+
+  while ((entry = readdir(dir)) != nullptr) {
+
+    if (entry->d_name[0] == '.') {
+
+      continue;
+    }
+
+    std::string device = std::string(POWER_SUPPLY) + entry->d_name + '/';
+
+    std::unique_ptr<ProcFile> type = open_attribute(device, "type"),
+                              scope = open_attribute(device, "scope");
+
+    if (type == nullptr || type->Read() != 0) {
+
+      continue;
+    }
+
+    if (strncmp(type->Data(), "Battery", 7) == 0) {
+
+      // batteries of mice, keyboards and the like report scope Device
+      if (scope != nullptr && scope->Read() == 0 &&
+          strncmp(scope->Data(), "Device", 6) == 0) {
+
+        continue;
+      }
+
+      struct s_battery battery;
+
+      battery.capacity = open_attribute(device, "capacity");
+
+      battery.energy_now = open_attribute(device, "energy_now");
+
+      battery.energy_full = open_attribute(device, "energy_full");
+
+      // some gauges only report charge, in µAh instead of µWh
+      if (battery.energy_now == nullptr || battery.energy_full == nullptr) {
+
+        battery.energy_now = open_attribute(device, "charge_now");
+
+        battery.energy_full = open_attribute(device, "charge_full");
+      }
+
+      battery.status = open_attribute(device, "status");
+
+      _batteries.push_back(std::move(battery));
+    } else if (strncmp(type->Data(), "Mains", 5) == 0 ||
+               strncmp(type->Data(), "USB", 3) == 0) {
+
+      std::unique_ptr<ProcFile> online = open_attribute(device, "online");
+
+      if (online != nullptr) {
+
+        _adapters.push_back(std::move(online));
+      }
+    }
+  }
+
+  closedir(dir);
+
+  return 0;
+}
+
+bool PowerSupply::_read(ProcFile *file, long &value) {
+
+  if (file == nullptr || file->Read() != 0 || file->Size() == 0) {
+
+    return false;
+  }
+
+  value = strtol(file->Data(), nullptr, 10);
+
+  return true;
+}
+
+int PowerSupply::Prefetch(ReadBatch &batch) {
+
+  if (!_discovered) {
+
+    _discover();
+  }
+
+  for (std::unique_ptr<ProcFile> &adapter : _adapters) {
+
+    batch.Add(*adapter);
+  }
+
+  for (struct s_battery &battery : _batteries) {
+
+    for (ProcFile *file :
+         {battery.capacity.get(), battery.energy_now.get(),
+          battery.energy_full.get(), battery.status.get()}) {
+
+      if (file != nullptr) {
+
+        batch.Add(*file);
+      }
+    }
+  }
+
+  return 0;
+}
+
+// The level is the mean over all batteries, weighted by their capacity.
+// A battery that is charging or discharging decides the status over one
+// that is full or idle.
+int PowerSupply::Sample(float &level, bool &online, States &status) {
+
+  if (!_discovered) {
+
+    _discover();
+  }
+
+  online = false;
+
+  for (std::unique_ptr<ProcFile> &adapter : _adapters) {
+
+    long value;
+
+    if (_read(adapter.get(), value) && value != 0) {
+
+      online = true;
+    }
+  }
+
+  double now = 0.0, full = 0.0;
+
+  status = States::Unknown;
+
+  for (struct s_battery &battery : _batteries) {
+
+    long value = 0, energy = 0, capacity = 0;
+
+    double fraction, weight = 1.0;
+
+    // every file Prefetch() queued is read on every path, so that none is
+    // left holding its batched data for the next sample
+    bool full_read = _read(battery.energy_full.get(), capacity),
+         capacity_read = _read(battery.capacity.get(), value),
+         energy_read = _read(battery.energy_now.get(), energy),
+         status_read =
+             battery.status != nullptr && battery.status->Read() == 0;
+
+    if (full_read && capacity > 0) {
+
+      weight = static_cast<double>(capacity);
+    }
+
+    if (capacity_read) {
+
+      fraction = static_cast<double>(value) / 100.0;
+    } else if (capacity > 0 && energy_read) {
+
+      fraction = static_cast<double>(energy) / static_cast<double>(capacity);
+    } else {
+
+      continue;
+    }
+
+    now += weight * fraction;
+
+    full += weight;
+
+    if (!status_read || status == States::Charging ||
+        status == States::Discharging) {
+
+      continue;
+    }
+
+    const char *text = battery.status->Data();
+
+    if (strncmp(text, "Charging", 8) == 0) {
+
+      status = States::Charging;
+    } else if (strncmp(text, "Discharging", 11) == 0) {
+
+      status = States::Discharging;
+    } else if (strncmp(text, "Full", 4) == 0) {
+
+      status = States::Full;
+    } else if (strncmp(text, "Not charging", 12) == 0) {
+
+      status = States::NotCharging;
+    }
+  }
+
+  level = full > 0.0 ? static_cast<float>(now / full) : -1.0f;
+
+  return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ *  @file   PowerSupply.h
+ *  @brief  Linux Power Supply Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef POWERSUPPLY_H_
+#define POWERSUPPLY_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+
+#include <memory>
+
+#include <string>
+
+#include <vector>
+
+#include "ProcFile.h"
+#include "ReadBatch.h"
+
+// Reads the state of the system batteries and mains adapters from
+// /sys/class/power_supply. Devices are looked up once and their attributes
+// are kept open, so a sample costs one pread(2) per attribute. Invalidate()
+// triggers a new lookup, e.g. after a power_supply hotplug uevent.
+// Prefetch() queues every attribute on a ReadBatch ahead of Sample().
+class PowerSupply {
+
+public:
+  enum class States { Unknown, Charging, Discharging, Full, NotCharging };
+
+  PowerSupply();
+
+  int Invalidate();
+
+  int Prefetch(ReadBatch &batch);
+
+  int Sample(float &level, bool &online, States &status);
+
+private:
+  struct s_battery {
+    std::unique_ptr<ProcFile> capacity, energy_now, energy_full, status;
+  };
+
+  int _discover();
+
+  static bool _read(ProcFile *file, long &value);
+
+  std::vector<struct s_battery> _batteries;
+
+  std::vector<std::unique_ptr<ProcFile>> _adapters;
+
+  bool _discovered;
+};
+
+inline int PowerSupply::Invalidate() {
+
+  _discovered = false;
+
+  return 0;
+}
+#endif // End of POWERSUPPLY_H_
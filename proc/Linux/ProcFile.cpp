@@ -0,0 +1,208 @@
+/**
+ *  @file   ProcFile.cpp
+ *  @brief  Persistent /proc File Reader Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "ProcFile.h"
+
+// most attributes hold a single value or a few lines; the buffer doubles
+// until a read of the file falls short of it
+static const size_t INITIAL = 256;
+
+// a seq_file hands out whole records only, and at most one page of them per
+// read, so a table keeps a page of room ahead of every read
+static const size_t PAGE = 4096;
+
+ProcFile::ProcFile()
+    : _flags(O_RDONLY), _layout(Layout::Attribute), _fd(-1), _capacity(0),
+      _size(0), _prefetched(false) {
+
+  _reserve(INITIAL);
+}
+
+ProcFile::ProcFile(const char *path, size_t size, Layout layout)
+    : _flags(O_RDONLY), _layout(layout), _fd(-1), _capacity(0), _size(0),
+      _prefetched(false) {
+
+  _reserve(size);
+
+  Open(path, O_RDONLY, layout);
+}
+
+ProcFile::~ProcFile() { Close(); }
+
+int ProcFile::Open(const char *path, int flags, Layout layout) {
+
+  Close();
+
+  _path = std::string(path);
+
+  _flags = flags;
+
+  _layout = layout;
+
+  _reserve(_layout == Layout::Table ? PAGE : INITIAL);
+
+  _fd = open(_path.c_str(), _flags | O_CLOEXEC);
+
+  return _fd < 0 ? 1 : 0;
+}
+
+void ProcFile::Close() {
+
+  _prefetched = false;
+
+  if (_fd >= 0) {
+
+    close(_fd);
+
+    _fd = -1;
+  }
+}
+
+int ProcFile::_reserve(size_t size) {
+
+  if (size <= _capacity) {
+
+    return 0;
+  }
+
+  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(size + 1);
+
+  if (_size > 0) {
+
+    std::copy(_buffer.get(), _buffer.get() + _size, buffer.get());
+  }
+
+  _buffer = std::move(buffer);
+
+  _capacity = size;
+
+  _buffer[_size] = '\0';
+
+  return 0;
+}
+
+int ProcFile::_reopen() {
+
+  if (_fd < 0 && !_path.empty()) {
+
+    _fd = open(_path.c_str(), _flags | O_CLOEXEC);
+  }
+
+  return _fd < 0 ? 1 : 0;
+}
+
+// Tells whether a read of length bytes, out of the request bytes asked for,
+// leaves more of the file to read, and if so makes room for it. An
+// attribute that filled the buffer may have been cut short; a table may
+// end a read short of the page to keep its next record whole.
+bool ProcFile::_more(size_t length, size_t request) {
+
+  if (_layout == Layout::Table ? length == 0 : length < request) {
+
+    _buffer[_size] = '\0';
+
+    return false;
+  }
+
+  if (_layout == Layout::Table && _capacity - _size < PAGE) {
+
+    _reserve(_size + PAGE);
+  } else if (_size == _capacity) {
+
+    _reserve(2 * _capacity);
+  }
+
+  return true;
+}
+
+// Reads on from _size until the end of the file.
+int ProcFile::_drain() {
+
+  while (true) {
+
+    size_t request = _capacity - _size;
+
+    ssize_t n = pread(_fd, _buffer.get() + _size, request, _size);
+
+    if (n < 0) {
+
+      if (errno == EINTR) {
+
+        continue;
+      }
+
+      Close();
+
+      _size = 0;
+
+      _buffer[0] = '\0';
+
+      return 1;
+    }
+
+    _size += n;
+
+    if (!_more(n, request)) {
+
+      return 0;
+    }
+  }
+}
+
+// Takes over the result of a batched read at _size into the rest of the
+// buffer and tells whether to read on, as _drain() would.
+bool ProcFile::_complete(long result) {
+
+  size_t request = _capacity - _size;
+
+  if (result < 0) {
+
+    Close();
+
+    _size = 0;
+
+    _buffer[0] = '\0';
+
+    return false;
+  }
+
+  _size += result;
+
+  if (_more(result, request)) {
+
+    return true;
+  }
+
+  _prefetched = true;
+
+  return false;
+}
+
+int ProcFile::Read() {
+
+  if (_prefetched) {
+
+    _prefetched = false;
+
+    return 0;
+  }
+
+  _read = std::chrono::steady_clock::now();
+
+  _size = 0;
+
+  _buffer[0] = '\0';
+
+  if (_reopen() != 0) {
+
+    return 1;
+  }
+
+  return _drain();
+}
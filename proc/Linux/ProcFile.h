@@ -0,0 +1,117 @@
+/**
+ *  @file   ProcFile.h
+ *  @brief  Persistent /proc File Reader Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef PROCFILE_H_
+#define PROCFILE_H_
+
+#include <cerrno>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <memory>
+
+#include <string>
+
+// Keeps a /proc (or /sys) file open and re-reads it from offset zero with
+// pread(2) into a buffer it owns. The descriptor is only reopened after a
+// read error, the buffer starts small and only grows when the file
+// outgrows it. An Attribute, a sysfs value or a single_open(9) file such as
+// /proc/stat, comes out whole and ends at the first short read; a Table, a
+// seq_file with a record per row such as /proc/diskstats, comes out a page
+// at a time and ends at the first empty read. A ReadBatch can read the file
+// ahead of time, together with others; the next Read() then hands out that
+// data instead of reading again.
+class ProcFile {
+
+  friend class ReadBatch;
+
+public:
+  enum class Layout { Attribute, Table };
+
+  ProcFile();
+
+  ProcFile(const char *path, size_t size = 256,
+           Layout layout = Layout::Attribute);
+
+  ~ProcFile();
+
+  ProcFile(const ProcFile &) = delete;
+
+  ProcFile &operator=(const ProcFile &) = delete;
+
+  int Open(const char *path, int flags = O_RDONLY,
+           Layout layout = Layout::Attribute);
+
+  int Read();
+
+  void Close();
+
+  int GetFileDescriptor();
+
+  bool fail();
+
+  bool good();
+
+  const char *Data();
+
+  size_t Size();
+
+  std::chrono::steady_clock::time_point ReadTime();
+
+private:
+  int _reserve(size_t size);
+
+  int _reopen();
+
+  int _drain();
+
+  bool _more(size_t length, size_t request);
+
+  bool _complete(long result);
+
+  std::string _path;
+
+  int _flags;
+
+  Layout _layout;
+
+  int _fd;
+
+  std::unique_ptr<char[]> _buffer;
+
+  size_t _capacity;
+
+  size_t _size;
+
+  std::chrono::steady_clock::time_point _read;
+
+  bool _prefetched;
+};
+
+inline int ProcFile::GetFileDescriptor() { return _fd; }
+
+inline bool ProcFile::fail() { return _fd < 0; }
+
+inline bool ProcFile::good() { return _fd >= 0; }
+
+inline const char *ProcFile::Data() { return _buffer.get(); }
+
+inline size_t ProcFile::Size() { return _size; }
+
+inline std::chrono::steady_clock::time_point ProcFile::ReadTime() {
+
+  return _read;
+}
+#endif // End of PROCFILE_H_
@@ -17,180 +17,1150 @@ ProcManager::~ProcManager() {
 
   _terminate_probe_thread = true;
 
-  _probe_condition.notify_one();
+  uint64_t event = 1;
 
-  _probe_thread.join();
+  write(_event_fd, &event, sizeof(event));
+
+  if (_probe_thread.joinable()) {
+
+    _probe_thread.join();
+  }
+
+  close(_uevent_fd);
+
+  close(_inotify_fd);
+
+  close(_event_fd);
+
+  close(_timer_fd);
+
+  close(_epoll_fd);
+}
+
+int ProcManager::_init(int argc, char *argv[]) {
+
+  _mask = static_cast<int>(ProcManager::Masks::Ignore);
+
+  std::fill(std::begin(_intervals), std::end(_intervals), 2000);
+
+  _stale_interval();
+
+  _sample = {};
+
+  proc_cpu1 = {};
+
+  proc_cpu2 = {};
+
+  proc_eth = {};
+
+  proc_burst_eth = {};
+
+  proc_burst = {};
+
+  _auto_eth = false;
+
+  _eth_rebase = true;
+
+  _proc_stat.Open("/proc/stat");
+
+  _proc_net_dev.Open("/proc/net/dev", O_RDONLY, ProcFile::Layout::Table);
+
+  _proc_meminfo.Open("/proc/meminfo");
+
+  std::fill(std::begin(_meminfo_offsets), std::end(_meminfo_offsets), 0);
+
+  _proc_vmstat.Open("/proc/vmstat", ProcFile::Layout::Table);
+
+  for (const char *key : {"pgfault", "pgmajfault", "pswpin", "pswpout"}) {
+
+    _proc_vmstat.AddKey(key);
+  }
+
+  _proc_snmp.Open("/proc/net/snmp");
+
+  _proc_snmp.AddKey("Tcp:RetransSegs");
+
+  _proc_netstat.Open("/proc/net/netstat");
+
+  _proc_netstat.AddKey("TcpExt:ListenDrops");
+
+  _proc_netstat.AddKey("TcpExt:ListenOverflows");
+
+  proc_vm = {};
+
+  proc_tcp = {};
+
+  _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+  _event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+  struct epoll_event event = {.events = EPOLLIN, .data = {.fd = _event_fd}};
+
+  epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _event_fd, &event);
+
+  _timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+
+  event = {.events = EPOLLIN, .data = {.fd = _timer_fd}};
+
+  epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _timer_fd, &event);
+
+  _inotify_fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+
+  _utmp_watch = inotify_add_watch(_inotify_fd, _PATH_UTMPX,
+                                  IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF);
+
+  _utmp_dirty = true;
+
+  _watch(_inotify_fd, [this] { return _utmp_event(); });
+
+  _uevent_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                      NETLINK_KOBJECT_UEVENT);
+
+  struct sockaddr_nl address = {};
+
+  address.nl_family = AF_NETLINK;
+
+  address.nl_groups = 1;
+
+  if (_uevent_fd >= 0 &&
+      bind(_uevent_fd, reinterpret_cast<struct sockaddr *>(&address),
+           sizeof(address)) == 0) {
+
+    _watch(_uevent_fd, [this] { return _uevent(); });
+  }
+
+  _route_dirty = true;
+
+  _watch(_default_route.GetFileDescriptor(), [this] {
+    _route_dirty = true;
+
+    return _default_route.Drain();
+  });
+
+  _watch(_cgroup_sampler.GetFileDescriptor(), [this] {
+    _cgroup_sampler.Update();
+
+    return 0;
+  });
+
+  const char *resources[] = {"/proc/pressure/cpu", "/proc/pressure/memory",
+                             "/proc/pressure/io"};
+
+  // wake up on a stall of 150 ms within 2 s, the finest window the kernel
+  // grants unprivileged processes
+  static const char trigger[] = "some 150000 2000000";
+
+  for (int n = 0; n < 3; n++) {
+
+    _psi[n].file.Open(resources[n], O_RDWR | O_NONBLOCK);
+
+    _psi[n].trigger =
+        _psi[n].file.good() &&
+        write(_psi[n].file.GetFileDescriptor(), trigger, sizeof(trigger)) > 0;
+
+    _psi[n].active = true;
+
+    _psi[n].some = _psi[n].full = 0;
+
+    if (!_psi[n].trigger) {
+
+      _psi[n].file.Open(resources[n]);
+
+      continue;
+    }
+
+    _watch(
+        _psi[n].file.GetFileDescriptor(),
+        [this, n] {
+          _psi[n].active = true;
+
+          return static_cast<int>(Masks::Pressure);
+        },
+        EPOLLPRI);
+  }
+
+  return 0;
+}
+
+// Adds a descriptor to the probe thread's epoll set. When it becomes readable
+// the handler runs on the probe thread and returns the mask of the sensors
+// to probe right away.
+int ProcManager::_watch(int fd, std::function<int()> handler,
+                        uint32_t events) {
+
+  if (fd < 0) {
+
+    return 1;
+  }
+
+  _handlers[fd] = handler;
+
+  struct epoll_event event = {.events = events, .data = {.fd = fd}};
+
+  return epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0 ? 0 : 1;
+}
+
+int ProcManager::SetInterval(Masks mask, int msec) {
+
+  for (int bit = 0; bit < 32; bit++) {
+
+    if (static_cast<int>(mask) & (1 << bit)) {
+
+      _intervals[bit] = std::max(msec, 1);
+    }
+  }
+
+  return _stale_interval();
+}
+
+// Bursts never publish a sample of their own, so they do not count.
+int ProcManager::_stale_interval() {
+
+  int interval = 0, mask = _mask & ~static_cast<int>(Masks::Burst);
+
+  for (int bit = 0; bit < 32; bit++) {
+
+    if ((mask & (1 << bit)) &&
+        (interval == 0 || _intervals[bit] < interval)) {
+
+      interval = _intervals[bit];
+    }
+  }
+
+  _stale_after = std::chrono::milliseconds(2 * std::max(interval, 1000));
+
+  return 0;
+}
+
+// Requests an immediate probe of every sensor and (re)starts the schedule.
+// Never waits for the probe thread: a request that arrives while another is
+// still pending is folded into it. The first request starts the probe
+// thread, so the Set*() calls that precede it are done before the thread
+// reads the configuration; the configuration is not to change after that.
+void ProcManager::Probe() {
+
+  if (!_probe_thread.joinable()) {
+
+    _probe_thread = std::thread(&ProcManager::_probe_thread_func, this);
+  }
+
+  if (_probe_execute.exchange(true)) {
+
+    return;
+  }
+
+  uint64_t event = 1;
+
+  write(_event_fd, &event, sizeof(event));
+}
+
+int ProcManager::_reschedule() {
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  _schedule = {};
+
+  for (int bit = 0; bit < 32; bit++) {
+
+    if (_mask & (1 << bit)) {
+
+      _schedule.push({now + std::chrono::milliseconds(_intervals[bit]), bit});
+    }
+  }
+
+  return 0;
+}
+
+// Sleeps in epoll_wait until the earliest sensor deadline or an event, then
+// probes only the sensors that are due. The deadline is armed on a timerfd
+// as an absolute CLOCK_MONOTONIC time, the clock behind steady_clock, so the
+// wakeup is as exact as the kernel timer and not rounded to milliseconds.
+void ProcManager::_probe_thread_func() {
+
+  struct epoll_event events[8];
+
+  while (true) {
+
+    // a zero it_value disarms the timer
+    struct itimerspec timer = {};
+
+    if (!_schedule.empty()) {
+
+      std::chrono::nanoseconds deadline =
+          _schedule.top().first.time_since_epoch();
+
+      timer.it_value.tv_sec =
+          std::chrono::duration_cast<std::chrono::seconds>(deadline).count();
+
+      timer.it_value.tv_nsec = (deadline % std::chrono::seconds(1)).count();
+
+      // a deadline of exactly 0 would disarm the timer instead
+      if (timer.it_value.tv_sec == 0 && timer.it_value.tv_nsec == 0) {
+
+        timer.it_value.tv_nsec = 1;
+      }
+    }
+
+    timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &timer, nullptr);
+
+    int nevents = epoll_wait(_epoll_fd, events, 8, -1);
+
+    if (nevents < 0 && errno != EINTR) {
+
+      break;
+    }
+
+    int mask = 0;
+
+    bool requested = false;
+
+    for (int n = 0; n < nevents; n++) {
+
+      if (events[n].data.fd == _event_fd) {
+
+        uint64_t event;
+
+        read(_event_fd, &event, sizeof(event));
+
+        if (_terminate_probe_thread) {
+
+          return;
+        }
+
+        if (_probe_execute) {
+
+          requested = true;
+
+          mask = _mask;
+
+          _reschedule();
+        }
+
+        continue;
+      }
+
+      if (events[n].data.fd == _timer_fd) {
+
+        uint64_t expirations;
+
+        read(_timer_fd, &expirations, sizeof(expirations));
+
+        continue;
+      }
+
+      std::unordered_map<int, std::function<int()>>::iterator handler =
+          _handlers.find(events[n].data.fd);
+
+      if (handler == _handlers.end()) {
+
+        continue;
+      }
+
+      int due = handler->second() & _mask;
+
+      // events only trigger probes once sampling has been started
+      if (!_schedule.empty()) {
+
+        mask |= due;
+      }
+    }
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+
+    while (!_schedule.empty() && _schedule.top().first <= now) {
+
+      t_deadline deadline = _schedule.top();
+
+      std::chrono::milliseconds interval(_intervals[deadline.second]);
+
+      _schedule.pop();
+
+      mask |= 1 << deadline.second;
+
+      deadline.first += interval;
+
+      // a sensor that missed a whole interval is late, do not catch up; a
+      // burst is late whenever a long probe runs
+      if (deadline.first <= now) {
+
+        if (deadline.second != __builtin_ctz(static_cast<int>(Masks::Burst))) {
+
+          ++_overruns;
+        }
+
+        deadline.first = now + interval;
+      }
+
+      _schedule.push(deadline);
+    }
+
+    if (mask == 0) {
+
+      continue;
+    }
+
+    // a burst on its own only adds to the ranges, the sample stays as is
+    if (mask == static_cast<int>(Masks::Burst)) {
+
+      _burst();
+
+      continue;
+    }
+
+    _sample.timestamp = std::chrono::steady_clock::now();
+
+    // a sensor stays in error until it probes fine again
+    _sample.errors = (_sample.errors & ~mask) | _probe(mask);
+
+    _sample.stale = false;
+
+    _sample.overruns = _overruns;
+
+    if (requested) {
+
+      _probe_execute = false;
+    }
+
+    _samples.Back() = _sample;
+
+    _samples.Publish();
+  }
+}
+
+// utmp is rewritten in place on every login and logout, and replaced now and
+// then by log rotation, in which case the watch moves to the new file.
+int ProcManager::_utmp_event() {
+
+  alignas(struct inotify_event) char buffer[4096];
+
+  bool replaced = false;
+
+  ssize_t n;
+
+  while ((n = read(_inotify_fd, buffer, sizeof(buffer))) > 0) {
+
+    const struct inotify_event *event;
+
+    for (char *p = buffer; p < buffer + n;
+         p += sizeof(struct inotify_event) + event->len) {
+
+      event = reinterpret_cast<const struct inotify_event *>(p);
+
+      if (event->wd == _utmp_watch &&
+          (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))) {
+
+        replaced = true;
+      }
+    }
+  }
+
+  if (replaced) {
+
+    inotify_rm_watch(_inotify_fd, _utmp_watch);
+
+    _utmp_watch = inotify_add_watch(_inotify_fd, _PATH_UTMPX,
+                                    IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF);
+  }
+
+  _utmp_dirty = true;
+
+  return static_cast<int>(Masks::Users);
+}
+
+// The kernel broadcasts a uevent for every device that is added, removed or
+// changes state, e.g. when the AC adapter is plugged in. Each message is an
+// "action@devpath" header followed by NUL separated KEY=value pairs.
+int ProcManager::_uevent() {
+
+  char buffer[8192];
+
+  struct sockaddr_nl sender;
+
+  socklen_t length = sizeof(sender);
+
+  int mask = 0;
+
+  ssize_t n;
+
+  while ((n = recvfrom(_uevent_fd, buffer, sizeof(buffer) - 1, 0,
+                       reinterpret_cast<struct sockaddr *>(&sender),
+                       &length)) > 0) {
+
+    length = sizeof(sender);
+
+    // only the kernel itself broadcasts on this group
+    if (sender.nl_pid != 0) {
+
+      continue;
+    }
+
+    buffer[n] = '\0';
+
+    const char *subsystem = "";
+
+    for (const char *p = buffer + strlen(buffer) + 1; p < buffer + n;
+         p += strlen(p) + 1) {
+
+      if (strncmp(p, "SUBSYSTEM=", 10) == 0) {
+
+        subsystem = p + 10;
+      }
+    }
+
+    // disks coming and going move the rows of /proc/diskstats
+    if (strcmp(subsystem, "block") == 0 &&
+        strncmp(buffer, "change@", 7) != 0) {
+
+      _block_devices.Invalidate();
+    }
+
+    // cores going on- and offline take their cpufreq and events with them
+    if ((strcmp(subsystem, "cpu") == 0 || strcmp(subsystem, "hwmon") == 0) &&
+        strncmp(buffer, "change@", 7) != 0) {
+
+      _core_sensors.Invalidate();
+
+      _perf_counters.Invalidate();
+    }
+
+    if (strcmp(subsystem, "power_supply") == 0) {
+
+      if (strncmp(buffer, "change@", 7) != 0) {
+
+        _power_supply.Invalidate();
+      }
+
+      mask |= static_cast<int>(Masks::Battery);
+    }
+  }
+
+  return mask;
+}
+
+int ProcManager::_scan_users() {
+
+  std::unordered_set<std::string> logged_in;
+
+  std::vector<std::string> users;
+
+  setutxent();
+
+  struct utmpx *s_utmpx;
+
+  while ((s_utmpx = getutxent()) != NULL) {
+
+    if (s_utmpx->ut_type != USER_PROCESS) {
+
+      continue;
+    }
+
+    // ut_user is not NUL terminated when the name fills the field
+    std::string user(s_utmpx->ut_user,
+                     strnlen(s_utmpx->ut_user, sizeof(s_utmpx->ut_user)));
+
+    if (logged_in.insert(user).second) {
+
+      users.push_back(user);
+    }
+  }
+
+  endutxent();
+
+  for (const std::string &user : users) {
+
+    if (_logged_in.find(user) == _logged_in.end()) {
+
+      _sample.logins.push_back(user);
+    }
+  }
+
+  for (const std::string &user : _logged_in) {
+
+    if (logged_in.find(user) == logged_in.end()) {
+
+      _sample.logouts.push_back(user);
+    }
+  }
+
+  _logged_in.swap(logged_in);
+
+  _sample.users.swap(users);
+
+  return 0;
+}
+
+// Points the network counters at another interface. The next probe takes
+// its counters as the new baseline instead of reporting the difference.
+int ProcManager::_set_eth(const std::string &eth) {
+
+  _eth = eth;
+
+  _eth_rebase = true;
+
+  return _link_stats.SetInterface(_eth);
+}
+
+// Returns the fields of the row whose name-th field equals match.
+int ProcManager::_find_row(ProcFile &file, char separator, int name,
+                           const std::string &match, const char **fields,
+                           size_t *lengths, int max) {
+
+  LineScanner scanner(file.Data(), file.Size(), separator);
+
+  if (!scanner.FindLine(match.data(), match.size(), name)) {
+
+    return 0;
+  }
+
+  return scanner.Fields(fields, lengths, max);
+}
+
+const char *ProcManager::_find_line(const char *data, const char *needle) {
+
+  const char *match = strstr(data, needle);
+
+  if (match == nullptr) {
+
+    return nullptr;
+  }
+
+  while (match > data && *(match - 1) != '\n') {
+
+    --match;
+  }
+
+  return match;
+}
+
+int ProcManager::_parse_stat(const char *data, const char *label,
+                             struct s_pcpu *pcpu, struct s_pcores *pcores) {
+
+  struct s_pcpu line;
+
+  unsigned long *fields[] = {&line.user,    &line.nice,  &line.sys,
+                             &line.idle,    &line.iowait, &line.irq,
+                             &line.softirq, &line.steal, &line.guest,
+                             &line.guest_nice};
+
+  int found = 1;
+
+  size_t length = strlen(label);
+
+  const char *p = data;
+
+  // the cpu lines lead the file, the scan ends with them
+  while (strncmp(p, "cpu", 3) == 0) {
+
+    const char *name = p;
+
+    p += 3;
+
+    bool core = *p >= '0' && *p <= '9';
+
+    size_t n = 0;
+
+    while (*p >= '0' && *p <= '9') {
+
+      n = 10 * n + (*p++ - '0');
+    }
+
+    bool match = static_cast<size_t>(p - name) == length &&
+                 strncmp(name, label, length) == 0;
+
+    for (unsigned long *field : fields) {
+
+      while (*p == ' ') {
+
+        ++p;
+      }
+
+      unsigned long value = 0;
+
+      while (*p >= '0' && *p <= '9') {
+
+        value = 10 * value + (*p++ - '0');
+      }
+
+      *field = value;
+    }
+
+    // guest time is already accounted for in user and nice
+    line.total = line.user + line.nice + line.sys + line.idle + line.iowait +
+                 line.irq + line.softirq + line.steal;
+
+    if (match) {
+
+      *pcpu = line;
+
+      found = 0;
+    }
+
+    if (core) {
+
+      if (n >= pcores->total.size()) {
+
+        pcores->busy.resize(n + 1, 0);
+
+        pcores->total.resize(n + 1, 0);
+      }
+
+      pcores->busy[n] = line.total - line.idle - line.iowait;
+
+      pcores->total[n] = line.total;
+    }
+
+    if ((p = strchr(p, '\n')) == nullptr) {
+
+      break;
+    }
+
+    ++p;
+  }
+
+  return found;
 }
 
-int ProcManager::_init(int argc, char *argv[]) {
+// Every key sits at the same byte offset on each read, the layout of
+// /proc/meminfo only depends on the kernel and its configuration. The
+// offsets are learned in one pass over all lines, and learned again when a
+// key is no longer found where it was. A key the kernel does not report is
+// remembered as std::string::npos and reads as zero.
+int ProcManager::_parse_meminfo(unsigned long *values) {
 
-  _mask = static_cast<int>(ProcManager::Masks::Ignore);
+  static const char *keys[MEMINFO_KEYS] = {"MemTotal:", "MemFree:",
+                                           "MemAvailable:", "Buffers:",
+                                           "Cached:", "SReclaimable:"};
+
+  static const size_t lengths[MEMINFO_KEYS] = {9, 8, 13, 8, 7, 13};
+
+  const char *data = _proc_meminfo.Data();
+
+  size_t size = _proc_meminfo.Size();
+
+  for (int pass = 0; pass < 2; pass++) {
+
+    int n;
+
+    for (n = 0; n < MEMINFO_KEYS; n++) {
+
+      size_t offset = _meminfo_offsets[n];
 
-  proc_cpu1 = {0};
+      if (offset == std::string::npos) {
 
-  proc_cpu2 = {0};
+        values[n] = 0;
 
-  proc_eth1 = {0};
+        continue;
+      }
+
+      if (offset + lengths[n] >= size ||
+          (offset > 0 && data[offset - 1] != '\n') ||
+          strncmp(data + offset, keys[n], lengths[n]) != 0) {
+
+        break;
+      }
+
+      // values are in kB
+      values[n] = 1024 * strtoul(data + offset + lengths[n], nullptr, 10);
+    }
+
+    if (n == MEMINFO_KEYS) {
+
+      return 0;
+    }
+
+    std::fill(std::begin(_meminfo_offsets), std::end(_meminfo_offsets),
+              std::string::npos);
+
+    for (const char *line = data; *line != '\0';) {
+
+      for (n = 0; n < MEMINFO_KEYS; n++) {
+
+        if (strncmp(line, keys[n], lengths[n]) == 0) {
+
+          _meminfo_offsets[n] = line - data;
+
+          break;
+        }
+      }
+
+      const char *eol = strchr(line, '\n');
+
+      if (eol == nullptr) {
+
+        break;
+      }
+
+      line = eol + 1;
+    }
+  }
+
+  return 1;
+}
 
-  proc_eth2 = {0};
+// Turns counters into rates per second over the time between the previous
+// and this read, both taken just before the counters were read; the first
+// read only sets the baseline. Wrapped counters are followed through
+// counter_delta().
+int ProcManager::_rates(const unsigned long long *values, float *const *rates,
+                        int n, struct s_pcounters *counters,
+                        std::chrono::steady_clock::time_point read) {
 
-  proc_io1 = {0};
+  float elapsed = std::chrono::duration<float>(read - counters->read).count();
 
-  proc_io2 = {0};
+  bool baseline = counters->read.time_since_epoch().count() > 0 && elapsed > 0;
+
+  for (int i = 0; i < n; i++) {
+
+    *rates[i] = baseline ? counter_delta(values[i], counters->values[i]) /
+                               elapsed
+                         : 0.0f;
+
+    counters->values[i] = values[i];
+  }
 
-  _probe_thread = std::thread(&ProcManager::_probe_thread_func, this);
+  counters->read = read;
 
   return 0;
 }
 
-void ProcManager::Probe() {
+int ProcManager::_parse_pressure(const char *data, const char *label,
+                                 float *avg10, unsigned long long *total) {
+
+  const char *line = _find_line(data, label), *eol;
+
+  if (line == nullptr) {
+
+    return 1;
+  }
+
+  eol = strchr(line, '\n');
 
-  if (_probe_execute) {
+  const char *field = strstr(line, "avg10=");
 
-    std::unique_lock<std::mutex> lock(_probe_mutex);
+  if (field != nullptr && (eol == nullptr || field < eol)) {
 
-    _probe_condition.wait(lock, [&] { return !_probe_execute; });
+    *avg10 = strtof(field + 6, nullptr);
   }
 
-  _probe_execute = true;
+  field = strstr(line, "total=");
+
+  if (field != nullptr && (eol == nullptr || field < eol)) {
+
+    *total = strtoull(field + 6, nullptr, 10);
+  }
 
-  _probe_condition.notify_one();
+  return 0;
 }
 
-void ProcManager::_probe_thread_func() {
+// Reads the byte counters of the interface, leaving values as they are when
+// it has none; 1 when neither netlink nor /proc/net/dev can be read.
+int ProcManager::_read_eth(unsigned long long *values,
+                           std::chrono::steady_clock::time_point *read) {
 
-  while (true) {
+  if (_auto_eth && _route_dirty) {
 
-    std::unique_lock<std::mutex> lock(_probe_mutex);
+    _route_dirty = false;
 
-    _probe_condition.wait(
-        lock, [&] { return _probe_execute || _terminate_probe_thread; });
+    if (_default_route.Update() == 0 && _default_route.Interface() != _eth) {
 
-    if (_terminate_probe_thread) {
-      break;
+      _set_eth(_default_route.Interface());
     }
+  }
+
+  const char *fields[10];
+
+  size_t lengths[10];
 
-    _probe();
+  *read = std::chrono::steady_clock::now();
 
-    _probe_execute = false;
+  if (_link_stats.Sample(values[0], values[1]) == 0) {
 
-    _probe_condition.notify_one();
+    // the counters came over netlink
+  } else if (_proc_net_dev.Read() != 0) {
+
+    return 1;
+  } else if (_find_row(_proc_net_dev, ':', 0, _eth, fields, lengths,
+                       10) == 10) {
+
+    // "eth0: rx_bytes packets errs drop fifo frame compressed multicast
+    // tx_bytes ..."
+    values[0] = LineScanner::Decimal(fields[1], lengths[1]);
+
+    values[1] = LineScanner::Decimal(fields[9], lengths[9]);
+  }
+
+  // the counters of another interface are a new baseline
+  if (_eth_rebase) {
+
+    proc_eth.read = proc_burst_eth.read = {};
+
+    _eth_rebase = false;
   }
+
+  return 0;
 }
 
-int ProcManager::_probe() {
+// Samples the network and disk counters many times between two probes of
+// them and keeps the lowest and highest rate seen, so that a burst of a few
+// milliseconds still shows next to the mean over the whole interval. Only
+// the cheap counters take part: one netlink request and /proc/diskstats.
+int ProcManager::_burst() {
+
+  float rates[NBursts];
+
+  bool sampled[NBursts] = {};
+
+  if (_mask & Masks::Eth) {
+
+    unsigned long long values[2] = {proc_burst_eth.values[0],
+                                    proc_burst_eth.values[1]};
 
-  if (_mask & Masks::CPU) {
+    std::chrono::steady_clock::time_point read;
 
-    std::ifstream fstream("/proc/stat", std::ios::in);
+    if (_read_eth(values, &read) == 0) {
 
-    if (fstream.fail()) {
+      // the first read only sets the baseline
+      sampled[Received] = sampled[Sent] =
+          proc_burst_eth.read.time_since_epoch().count() > 0;
 
-      return 1;
+      float *const eth[] = {&rates[Received], &rates[Sent]};
+
+      _rates(values, eth, 2, &proc_burst_eth, read);
     }
+  }
 
-    std::string line;
+  if (_mask & Masks::IO) {
 
-    while (std::getline(fstream, line)) {
+    sampled[Read] = sampled[Written] =
+        _block_devices.SampleBurst(rates[Read], rates[Written]) == 0;
+  }
 
-      if (line.find(_cpu) != std::string::npos) {
+  for (int n = 0; n < NBursts; n++) {
 
-        break;
-      }
+    if (!sampled[n]) {
+
+      continue;
     }
 
-    sscanf(line.c_str(), "%*s %lu %lu %lu %lu", &proc_cpu2.user,
-           &proc_cpu2.nice, &proc_cpu2.sys, &proc_cpu2.idle);
+    if (proc_burst.samples[n]++ == 0) {
+
+      proc_burst.min[n] = proc_burst.max[n] = rates[n];
 
-    fstream.close();
+      continue;
+    }
 
-    proc_cpu2.total =
-        proc_cpu2.user + proc_cpu2.nice + proc_cpu2.sys + proc_cpu2.idle;
+    proc_burst.min[n] = std::min(proc_burst.min[n], rates[n]);
 
-    float diff = proc_cpu2.total - proc_cpu1.total;
+    proc_burst.max[n] = std::max(proc_burst.max[n], rates[n]);
+  }
 
-    if (diff > 0.0f) {
+  return 0;
+}
 
-      cpu.user = (proc_cpu2.user - proc_cpu1.user) / diff;
+// Hands over the range of the rates seen since the previous probe around
+// the mean over the whole interval, and starts a new range.
+int ProcManager::_close_burst(int n, float mean, struct s_range *range) {
 
-      cpu.nice = (proc_cpu2.nice - proc_cpu1.nice) / diff;
+  *range = {mean, mean, mean};
 
-      cpu.sys = (proc_cpu2.sys - proc_cpu1.sys) / diff;
+  if (proc_burst.samples[n] > 0) {
 
-      cpu.idle = (proc_cpu2.idle - proc_cpu1.idle) / diff;
+    range->min = std::min(proc_burst.min[n], mean);
 
-      proc_cpu1 = proc_cpu2;
-    }
+    range->max = std::max(proc_burst.max[n], mean);
   }
 
-  if (_mask & Masks::Eth) {
+  proc_burst.samples[n] = 0;
 
-    std::ifstream fstream("/proc/net/dev", std::ios::in);
+  return 0;
+}
 
-    if (fstream.fail()) {
+// Queues the files of every due sensor on the read batch and reads them
+// all at once; the sensors below then find their data already in place.
+int ProcManager::_prefetch(int mask) {
 
-      return 1;
-    }
+  if (!_read_batch.good()) {
+
+    return 0;
+  }
 
-    std::string line;
+  if (mask & Masks::CPU) {
 
-    while (std::getline(fstream, line)) {
+    _read_batch.Add(_proc_stat);
+  }
 
-      if (line.find(_eth) != std::string::npos) {
+  if (mask & Masks::IO) {
 
-        break;
+    _block_devices.Prefetch(_read_batch);
+  }
+
+  if (mask & Masks::Mem) {
+
+    _read_batch.Add(_proc_meminfo);
+  }
+
+  if (mask & Masks::Battery) {
+
+    _power_supply.Prefetch(_read_batch);
+  }
+
+  if (mask & Masks::Pressure) {
+
+    for (int n = 0; n < 3; n++) {
+
+      if (_psi[n].active) {
+
+        _read_batch.Add(_psi[n].file);
       }
     }
+  }
+
+  if (mask & Masks::Cgroups) {
 
-    sscanf(line.c_str(), " %*s %lu %*d %*d %*d %*d %*d %*d %*d %lu",
-           &proc_eth2.received, &proc_eth2.sent);
+    _cgroup_sampler.Prefetch(_read_batch);
+  }
+
+  if (mask & Masks::VM) {
 
-    fstream.close();
+    _proc_vmstat.Prefetch(_read_batch);
+  }
 
-    eth.received = proc_eth2.received - proc_eth1.received;
+  if (mask & Masks::TCP) {
 
-    eth.sent = proc_eth2.sent - proc_eth1.sent;
+    _proc_snmp.Prefetch(_read_batch);
 
-    proc_eth1 = proc_eth2;
+    _proc_netstat.Prefetch(_read_batch);
   }
 
-  if (_mask & Masks::IO) {
+  if (mask & Masks::Interrupts) {
 
-    std::ifstream fstream("/proc/diskstats", std::ios::in);
+    _interrupt_sampler.Prefetch(_read_batch);
+  }
 
-    if (fstream.fail()) {
+  return _read_batch.Submit();
+}
 
-      return 1;
-    }
+// Probes the sensors in mask and returns those that failed; a failing
+// sensor keeps its previous values and does not hold up the others.
+int ProcManager::_probe(int mask) {
 
-    std::string line;
+  int failed = 0;
 
-    while (std::getline(fstream, line)) {
+  _prefetch(mask);
 
-      if (line.find(_io) != std::string::npos) {
+  if (mask & Masks::CPU) {
 
-        break;
+    if (_proc_stat.Read() != 0) {
+
+      failed |= static_cast<int>(Masks::CPU);
+    } else {
+
+      // leaves proc_cpu2 untouched when the configured label is absent
+      _parse_stat(_proc_stat.Data(), _cpu.c_str(), &proc_cpu2, &proc_cores2);
+
+      float diff = proc_cpu2.total - proc_cpu1.total;
+
+      if (diff > 0.0f) {
+
+        _sample.cpu.user = (proc_cpu2.user - proc_cpu1.user) / diff;
+
+        _sample.cpu.nice = (proc_cpu2.nice - proc_cpu1.nice) / diff;
+
+        _sample.cpu.sys = (proc_cpu2.sys + proc_cpu2.irq + proc_cpu2.softirq -
+                           proc_cpu1.sys - proc_cpu1.irq - proc_cpu1.softirq) /
+                          diff;
+
+        _sample.cpu.idle = (proc_cpu2.idle - proc_cpu1.idle) / diff;
+
+        _sample.cpu.iowait = (proc_cpu2.iowait - proc_cpu1.iowait) / diff;
+
+        _sample.cpu.steal = (proc_cpu2.steal - proc_cpu1.steal) / diff;
+
+        proc_cpu1 = proc_cpu2;
+      }
+
+      size_t ncores = proc_cores2.total.size();
+
+      proc_cores1.busy.resize(ncores, 0);
+
+      proc_cores1.total.resize(ncores, 0);
+
+      _sample.cores.resize(ncores, 0.0f);
+
+      for (size_t n = 0; n < ncores; n++) {
+
+        float total = proc_cores2.total[n] - proc_cores1.total[n];
+
+        if (total > 0.0f) {
+
+          _sample.cores[n] =
+              (proc_cores2.busy[n] - proc_cores1.busy[n]) / total;
+        }
       }
+
+      proc_cores1 = proc_cores2;
+    }
+  }
+
+  // the ranges end where the means end
+  if (mask & Masks::Burst) {
+
+    _burst();
+  }
+
+  if (mask & Masks::Eth) {
+
+    unsigned long long values[2] = {proc_eth.values[0], proc_eth.values[1]};
+
+    std::chrono::steady_clock::time_point read;
+
+    if (_read_eth(values, &read) != 0) {
+
+      failed |= static_cast<int>(Masks::Eth);
+    } else {
+
+      float *const rates[] = {&_sample.eth.received, &_sample.eth.sent};
+
+      _rates(values, rates, 2, &proc_eth, read);
+
+      _close_burst(Received, _sample.eth.received, &_sample.burst.received);
+
+      _close_burst(Sent, _sample.eth.sent, &_sample.burst.sent);
     }
+  }
+
+  if (mask & Masks::IO) {
+
+    struct BlockDevices::s_io io;
+
+    if (_block_devices.Sample(io) != 0) {
 
-    sscanf(line.c_str(), "%*d %*d %*s %*d %*d %lu %*d %*d %*d %lu",
-           &proc_io2.read, &proc_io2.write);
+      failed |= static_cast<int>(Masks::IO);
+    } else {
 
-    fstream.close();
+      _sample.io.read = io.read;
 
-    io.read = 512 * (proc_io2.read - proc_io1.read);
+      _sample.io.write = io.written;
 
-    io.write = 512 * (proc_io2.write - proc_io1.write);
+      _sample.io.utilization = io.utilization;
 
-    proc_io1 = proc_io2;
+      _sample.io.queue = io.queue;
+
+      _sample.io.await = io.await;
+
+      _close_burst(Read, _sample.io.read, &_sample.burst.read);
+
+      _close_burst(Written, _sample.io.write, &_sample.burst.write);
+    }
   }
 
-  if (_mask & Masks::EMail) {
+  if (mask & Masks::EMail) {
 
     // Do Email
   }
 
-  if (_mask & Masks::Host) {
+  if (mask & Masks::Host) {
 
     char *user = getenv("USER"), *host = getenv("HOST");
 
@@ -207,65 +1177,229 @@ int ProcManager::_probe() {
     }
   }
 
-  if (_mask & Masks::Alarm) {
+  if (mask & Masks::Alarm) {
 
     // Do Alarm
   }
 
-  if (_mask & Masks::Mem) {
+  if (mask & Masks::Mem) {
+
+    unsigned long values[MEMINFO_KEYS];
+
+    if (_proc_meminfo.Read() != 0 || _parse_meminfo(values) != 0) {
+
+      failed |= static_cast<int>(Masks::Mem);
+    } else {
+
+      _sample.memory.total = values[0];
+
+      _sample.memory.free = values[1];
+
+      _sample.memory.buffers = values[3];
+
+      // slab that can be reclaimed is as good as page cache
+      _sample.memory.cached = values[4] + values[5];
+
+      // MemAvailable appeared in Linux 3.14
+      _sample.memory.available =
+          _meminfo_offsets[2] != std::string::npos
+              ? values[2]
+              : _sample.memory.free + _sample.memory.buffers +
+                    _sample.memory.cached;
+    }
+  }
+
+  if ((mask & Masks::Disk) && _disk_sampler.Sample(_sample.disks) != 0) {
+
+    failed |= static_cast<int>(Masks::Disk);
+  }
+
+  if (mask & Masks::Users) {
+
+    // logins and logouts are relative to the previous probe of the users,
+    // and are published along with whatever is probed until the next one
+    _sample.logins.clear();
+
+    _sample.logouts.clear();
+
+    // without a watch on utmp there is no telling, scan every time
+    if (_utmp_watch < 0) {
+
+      _utmp_watch =
+          inotify_add_watch(_inotify_fd, _PATH_UTMPX,
+                            IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF);
+
+      _utmp_dirty = true;
+    }
+
+    if (_utmp_dirty) {
 
-    if (sysinfo(&memory) == -1) {
+      _utmp_dirty = false;
 
-      return 1;
+      _scan_users();
     }
   }
 
-  if (_mask & Masks::Disk) {
+  if (mask & Masks::Battery) {
+
+    bool online;
+
+    PowerSupply::States status;
+
+    _power_supply.Sample(_sample.battery.level, online, status);
+
+    if (_sample.battery.level < 0.0f) {
+
+      _sample.battery.powerstate = PowerStates::Unknown;
+    } else if (status == PowerSupply::States::Charging) {
+
+      _sample.battery.powerstate = PowerStates::BatteryCharging;
+    } else if (status == PowerSupply::States::Discharging) {
+
+      _sample.battery.powerstate = PowerStates::BatteryDischarging;
+    } else if (status == PowerSupply::States::Full ||
+               status == PowerSupply::States::NotCharging || online) {
 
-    if (statfs(_disk.c_str(), &disk) != 0) {
+      _sample.battery.powerstate = PowerStates::ACPower;
+    } else {
 
-      return 1;
+      _sample.battery.powerstate = PowerStates::BatteryDischarging;
     }
   }
 
-  if (_mask & Masks::Users) {
+  if (mask & Masks::Pressure) {
 
-    setutxent();
+    struct s_stall *stalls[] = {&_sample.pressure.cpu,
+                                &_sample.pressure.memory, &_sample.pressure.io};
 
-    struct utmpx *s_utmpx;
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
 
-    while ((s_utmpx = getutxent()) != NULL) {
+    std::chrono::microseconds window =
+        std::chrono::milliseconds(2 * GetInterval(Masks::Pressure));
 
-      if (s_utmpx->ut_type == USER_PROCESS) {
+    for (int n = 0; n < 3; n++) {
 
-        int s;
+      // a resource with a trigger is only read while it is stalling
+      if (!_psi[n].active || _psi[n].file.Read() != 0) {
 
-        for (s = users.size(); s--;) {
+        continue;
+      }
 
-          if (std::find(users.begin(), users.end(),
-                        std::string(s_utmpx->ut_user)) != users.end()) {
+      float some10 = 0.0f, full10 = 0.0f;
 
-            break;
-          }
-        }
+      unsigned long long some = _psi[n].some, full = _psi[n].full;
 
-        if (s < 0) {
+      _parse_pressure(_psi[n].file.Data(), "some ", &some10, &some);
 
-          users.push_back(std::string(s_utmpx->ut_user));
-        }
+      _parse_pressure(_psi[n].file.Data(), "full ", &full10, &full);
+
+      std::chrono::microseconds elapsed =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              now - _psi[n].read);
+
+      // totals are in microseconds of stall, the averages in percent
+      if (elapsed.count() > 0 && elapsed <= window) {
+
+        stalls[n]->some = static_cast<float>(some - _psi[n].some) /
+                          static_cast<float>(elapsed.count());
+
+        stalls[n]->full = static_cast<float>(full - _psi[n].full) /
+                          static_cast<float>(elapsed.count());
+      } else {
+
+        stalls[n]->some = some10 / 100.0f;
+
+        stalls[n]->full = full10 / 100.0f;
+      }
+
+      stalls[n]->some = std::clamp(stalls[n]->some, 0.0f, 1.0f);
+
+      stalls[n]->full = std::clamp(stalls[n]->full, 0.0f, 1.0f);
+
+      // without a stall since the last read, sleep until the next trigger
+      if (_psi[n].trigger && some == _psi[n].some && elapsed <= window) {
+
+        _psi[n].active = false;
+
+        stalls[n]->some = stalls[n]->full = 0.0f;
       }
+
+      _psi[n].some = some;
+
+      _psi[n].full = full;
+
+      _psi[n].read = now;
     }
+  }
+
+  if (mask & Masks::Cgroups) {
 
-    endutxent();
+    // without a cgroup v2 hierarchy the list simply stays empty
+    _cgroup_sampler.Sample(_sample.cgroups);
   }
 
-  if (_mask & Masks::Battery) {
+  if ((mask & Masks::Processes) &&
+      _process_sampler.Sample(_sample.processes) != 0) {
 
-    // Do battery
-    battery.level = -1;
+    failed |= static_cast<int>(Masks::Processes);
+  }
+
+  if ((mask & Masks::Sensors) && _core_sensors.Sample(_sample.sensors) != 0) {
 
-    battery.powerstate = PowerStates::Unknown;
+    failed |= static_cast<int>(Masks::Sensors);
   }
 
-  return 0;
+  if ((mask & Masks::Interrupts) &&
+      _interrupt_sampler.Sample(_sample.interrupts) != 0) {
+
+    failed |= static_cast<int>(Masks::Interrupts);
+  }
+
+  if ((mask & Masks::Perf) && _perf_counters.Sample(_sample.perf) != 0) {
+
+    failed |= static_cast<int>(Masks::Perf);
+  }
+
+  if (mask & Masks::VM) {
+
+    if (_proc_vmstat.Read() != 0) {
+
+      failed |= static_cast<int>(Masks::VM);
+    } else {
+
+      unsigned long long values[4];
+
+      for (int n = 0; n < 4; n++) {
+
+        values[n] = _proc_vmstat.Value(n);
+      }
+
+      float *const rates[] = {&_sample.vm.faults, &_sample.vm.majfaults,
+                              &_sample.vm.swapin, &_sample.vm.swapout};
+
+      _rates(values, rates, 4, &proc_vm, _proc_vmstat.ReadTime());
+    }
+  }
+
+  if (mask & Masks::TCP) {
+
+    if (_proc_snmp.Read() != 0 || _proc_netstat.Read() != 0) {
+
+      failed |= static_cast<int>(Masks::TCP);
+    } else {
+
+      unsigned long long values[3] = {_proc_snmp.Value(0),
+                                      _proc_netstat.Value(0),
+                                      _proc_netstat.Value(1)};
+
+      float *const rates[] = {&_sample.tcp.retransmits,
+                              &_sample.tcp.listendrops,
+                              &_sample.tcp.listenoverflows};
+
+      _rates(values, rates, 3, &proc_tcp, _proc_snmp.ReadTime());
+    }
+  }
+
+  return failed;
 }
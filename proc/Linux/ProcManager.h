@@ -14,8 +14,14 @@
 
 #include <sys/mount.h>
 #include <sys/param.h>
+#include <sys/socket.h>
 #include <sys/statfs.h>
-#include <sys/sysinfo.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+
+#include <linux/netlink.h>
 
 #include <utmpx.h>
 
@@ -29,11 +35,43 @@
 
 #include <algorithm>
 
-#include <condition_variable>
+#include <atomic>
+
+#include <chrono>
+
+#include <functional>
+
+#include <queue>
 
 #include <thread>
+
+#include <unordered_map>
+
+#include <unordered_set>
+
+#include "TripleBuffer.h"
+
+#include "BlockDevices.h"
+#include "CgroupSampler.h"
+#include "CoreSensors.h"
+#include "Counter.h"
+#include "DefaultRoute.h"
+#include "DiskSampler.h"
+#include "InterruptSampler.h"
+#include "LineScanner.h"
+#include "LinkStats.h"
+#include "PerfCounters.h"
+#include "PowerSupply.h"
+#include "ProcFile.h"
+#include "ProcTable.h"
+#include "ProcessSampler.h"
+#include "ReadBatch.h"
+
 class ProcManager {
 
+  // bench/ProcStat.cpp times _parse_stat() against sscanf(3)
+  friend class ProcStatBench;
+
 public:
   enum class Masks {
     Ignore = 0L,
@@ -47,24 +85,57 @@ public:
     Host = 1L << 8,
     Users = 1L << 9,
     Battery = 1L << 10,
-    All = 1L << 12 
+    Pressure = 1L << 11,
+    Cgroups = 1L << 12,
+    VM = 1L << 13,
+    TCP = 1L << 14,
+    Processes = 1L << 15,
+    Burst = 1L << 16,
+    Sensors = 1L << 17,
+    Interrupts = 1L << 18,
+    Perf = 1L << 19,
+    All = 1L << 20
   };
 
   struct s_cpu {
-    float user, nice, sys, idle;
-  } cpu;
-
-  struct sysinfo memory;
-
-  struct statfs disk;
+    float user, nice, sys, idle, iowait, steal;
+  };
 
   struct s_eth {
-    unsigned long received, sent;
-  } eth;
+    float received, sent;
+  };
 
   struct s_io {
-    unsigned long read, write;
-  } io;
+    float read, write, utilization, queue, await;
+  };
+
+  struct s_memory {
+    unsigned long total, free, available, buffers, cached;
+  };
+
+  struct s_vm {
+    float faults, majfaults, swapin, swapout;
+  };
+
+  struct s_tcp {
+    float retransmits, listendrops, listenoverflows;
+  };
+
+  struct s_range {
+    float min, max, mean;
+  };
+
+  struct s_burst {
+    struct s_range received, sent, read, write;
+  };
+
+  struct s_stall {
+    float some, full;
+  };
+
+  struct s_pressure {
+    struct s_stall cpu, memory, io;
+  };
 
   enum class PowerStates {
     Unknown,
@@ -77,9 +148,31 @@ public:
   struct s_battery {
     PowerStates powerstate;
     float level;
-  } battery;
+  };
 
-  std::vector<std::string> users;
+  struct s_sample {
+    struct s_cpu cpu;
+    std::vector<float> cores;
+    struct s_memory memory;
+    std::vector<DiskSampler::s_disk> disks;
+    std::vector<CgroupSampler::s_cgroup> cgroups;
+    std::vector<ProcessSampler::s_process> processes;
+    struct s_eth eth;
+    struct s_io io;
+    struct s_battery battery;
+    struct s_pressure pressure;
+    struct s_vm vm;
+    struct s_tcp tcp;
+    struct s_burst burst;
+    struct CoreSensors::s_sensors sensors;
+    struct InterruptSampler::s_interrupts interrupts;
+    struct PerfCounters::s_perf perf;
+    std::vector<std::string> users, logins, logouts;
+    std::chrono::steady_clock::time_point timestamp;
+    unsigned long overruns;
+    int errors;
+    bool stale;
+  };
 
   ProcManager();
 
@@ -97,50 +190,185 @@ public:
 
   int SetIO(const char *io);
 
-  void  Probe();
+  int SetCgroups(int top);
+
+  int SetProcesses(int top);
+
+  int SetUring(bool uring);
+
+  int SetInterval(Masks mask, int msec);
+
+  int GetInterval(Masks mask);
+
+  void Probe();
+
+  const struct s_sample &Snapshot();
 
 private:
   int _init(int argc, char *argv[]);
 
-  int _probe();
+  int _probe(int mask);
+
+  struct s_pcounters {
+    unsigned long long values[4];
+    std::chrono::steady_clock::time_point read;
+  } proc_eth, proc_burst_eth, proc_vm, proc_tcp;
+
+  enum Bursts { Received, Sent, Read, Written, NBursts };
+
+  struct s_pburst {
+    float min[NBursts], max[NBursts];
+    unsigned long samples[NBursts];
+  } proc_burst;
+
+  int _burst();
+
+  int _close_burst(int n, float mean, struct s_range *range);
+
+  int _read_eth(unsigned long long *values,
+                std::chrono::steady_clock::time_point *read);
+
+  int _reschedule();
+
+  int _stale_interval();
+
+  int _watch(int fd, std::function<int()> handler, uint32_t events = EPOLLIN);
+
+  int _utmp_event();
+
+  int _scan_users();
+
+  int _uevent();
+
+  int _set_eth(const std::string &eth);
+
+  static const char *_find_line(const char *data, const char *needle);
+
+  static int _find_row(ProcFile &file, char separator, int name,
+                       const std::string &match, const char **fields,
+                       size_t *lengths, int max);
+
+  int _parse_meminfo(unsigned long *values);
+
+  int _prefetch(int mask);
+
+  static int _rates(const unsigned long long *values, float *const *rates,
+                    int n, struct s_pcounters *counters,
+                    std::chrono::steady_clock::time_point read);
+
+  static int _parse_pressure(const char *data, const char *label,
+                             float *avg10, unsigned long long *total);
 
   void _probe_thread_func();
 
   int _mask;
 
+  struct s_sample _sample;
+
+  TripleBuffer<struct s_sample> _samples;
+
   struct s_pcpu {
 
-    unsigned long user, nice, sys, idle, total;
+    unsigned long user, nice, sys, idle, iowait, irq, softirq, steal, guest,
+        guest_nice, total;
   } proc_cpu1, proc_cpu2;
 
-  struct s_peth {
-
-    unsigned long received, sent;
-  } proc_eth1, proc_eth2;
+  struct s_pcores {
 
-  struct s_pio {
-    unsigned long read, write;
-  } proc_io1, proc_io2;
+    std::vector<unsigned long> busy, total;
+  } proc_cores1, proc_cores2;
 
-  std::string _disk;
+  static int _parse_stat(const char *data, const char *label,
+                         struct s_pcpu *pcpu, struct s_pcores *pcores);
 
   std::string _cpu;
 
   std::string _eth;
 
-  std::string _io;
+  bool _auto_eth, _eth_rebase, _route_dirty;
+
+  DefaultRoute _default_route;
 
   std::string _host;
 
-  std::thread _probe_thread;
+  ReadBatch _read_batch;
+
+  ProcFile _proc_stat;
+
+  LinkStats _link_stats;
+
+  ProcFile _proc_net_dev;
+
+  BlockDevices _block_devices;
+
+  ProcFile _proc_meminfo;
+
+  static const int MEMINFO_KEYS = 6;
+
+  size_t _meminfo_offsets[MEMINFO_KEYS];
+
+  ProcTable _proc_vmstat;
+
+  ProcTable _proc_snmp;
+
+  ProcTable _proc_netstat;
+
+  DiskSampler _disk_sampler;
+
+  int _inotify_fd;
+
+  int _utmp_watch;
+
+  bool _utmp_dirty;
 
-  std::condition_variable _probe_condition;
+  std::unordered_set<std::string> _logged_in;
 
-  std::mutex _probe_mutex;
+  int _uevent_fd;
 
-  bool _terminate_probe_thread = false;
+  PowerSupply _power_supply;
 
-  bool _probe_execute = false;
+  CgroupSampler _cgroup_sampler;
+
+  ProcessSampler _process_sampler;
+
+  CoreSensors _core_sensors;
+
+  InterruptSampler _interrupt_sampler;
+
+  PerfCounters _perf_counters;
+
+  struct s_ppsi {
+    ProcFile file;
+    bool trigger, active;
+    unsigned long long some, full;
+    std::chrono::steady_clock::time_point read;
+  } _psi[3];
+
+  int _intervals[32];
+
+  std::chrono::milliseconds _stale_after;
+
+  typedef std::pair<std::chrono::steady_clock::time_point, int> t_deadline;
+
+  std::priority_queue<t_deadline, std::vector<t_deadline>,
+                      std::greater<t_deadline>>
+      _schedule;
+
+  int _epoll_fd;
+
+  int _event_fd;
+
+  int _timer_fd;
+
+  std::unordered_map<int, std::function<int()>> _handlers;
+
+  std::thread _probe_thread;
+
+  std::atomic<bool> _terminate_probe_thread{false};
+
+  std::atomic<bool> _probe_execute{false};
+
+  std::atomic<unsigned long> _overruns{0};
 };
 
 inline int operator&(int a, ProcManager::Masks b) {
@@ -165,9 +393,7 @@ inline int operator^(ProcManager::Masks a, ProcManager::Masks b) {
 
 inline int ProcManager::SetDisk(const char *path) {
 
-  _disk = std::string(path);
-
-  return 0;
+  return _disk_sampler.SetPaths(path);
 }
 
 inline int ProcManager::SetCPU(const char *cpu) {
@@ -177,24 +403,68 @@ inline int ProcManager::SetCPU(const char *cpu) {
   return 0;
 }
 
+// "auto" follows the interface of the default route
 inline int ProcManager::SetEth(const char *eth) {
 
-  _eth = std::string(eth);
+  _auto_eth = strcmp(eth, "auto") == 0;
 
-  return 0;
+  return _set_eth(_auto_eth ? "" : eth);
 }
 
-inline int ProcManager::SetIO(const char *io) {
+inline int ProcManager::SetCgroups(int top) {
 
-  _io = std::string(io);
+  return _cgroup_sampler.SetTop(std::max(top, 0));
+}
 
-  return 0;
+inline int ProcManager::SetProcesses(int top) {
+
+  return _process_sampler.SetTop(std::max(top, 0));
+}
+
+// Reads the files of every probe through one io_uring batch; 1 when the
+// kernel does not offer io_uring, which leaves the files to pread(2).
+inline int ProcManager::SetUring(bool uring) {
+
+  if (!uring) {
+
+    _read_batch.Close();
+
+    return 0;
+  }
+
+  return _read_batch.Open();
+}
+
+inline int ProcManager::SetIO(const char *io) {
+
+  return _block_devices.SetDevices(io);
 }
 
 inline int ProcManager::SetProcMask(int mask) {
 
   _mask = mask;
 
-  return 0;
+  return _stale_interval();
+}
+
+inline int ProcManager::GetInterval(Masks mask) {
+
+  return _intervals[__builtin_ctz(static_cast<int>(mask))];
+}
+// A sample is stale once it is older than twice the shortest interval.
+// Until the probe thread first publishes, Snapshot() hands out an empty
+// sample without a timestamp, which is not stale but not there yet.
+inline const struct ProcManager::s_sample &ProcManager::Snapshot() {
+
+  _samples.Acquire();
+
+  if (_samples.Front().timestamp.time_since_epoch().count() > 0 &&
+      std::chrono::steady_clock::now() - _samples.Front().timestamp >
+          _stale_after) {
+
+    _samples.Front().stale = true;
+  }
+
+  return _samples.Front();
 }
 #endif // End of PROCMANAGER_H_
@@ -0,0 +1,238 @@
+/**
+ *  @file   ProcTable.cpp
+ *  @brief  Linux /proc Key-Value Table Reader Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "ProcTable.h"
+
+// Returns the start of the column-th blank separated token of a line, the
+// prefix of a table line being token zero.
+static const char *find_column(const char *line, size_t column) {
+
+  while (column-- > 0) {
+
+    while (*line != ' ' && *line != '\n' && *line != '\0') {
+
+      ++line;
+    }
+
+    if (*line != ' ') {
+
+      return nullptr;
+    }
+
+    while (*line == ' ') {
+
+      ++line;
+    }
+  }
+
+  return line;
+}
+
+static bool is_token(const char *token, const std::string &name) {
+
+  return strncmp(token, name.c_str(), name.size()) == 0 &&
+         (token[name.size()] == ' ' || token[name.size()] == '\n' ||
+          token[name.size()] == '\0');
+}
+
+ProcTable::ProcTable() {}
+
+int ProcTable::Open(const char *path, ProcFile::Layout layout) {
+
+  return _file.Open(path, O_RDONLY, layout);
+}
+
+int ProcTable::AddKey(const char *key) {
+
+  const char *colon = strchr(key, ':');
+
+  struct s_key entry = {"", key, 0, 0, false, 0};
+
+  if (colon != nullptr) {
+
+    entry.prefix = std::string(key, colon - key + 1);
+
+    entry.name = std::string(colon + 1);
+  }
+
+  _keys.push_back(entry);
+
+  // an unknown layout forces a scan on the first read
+  _order.clear();
+
+  return _keys.size() - 1;
+}
+
+int ProcTable::_scan() {
+
+  std::unordered_map<std::string_view, int> names;
+
+  for (size_t k = 0; k < _keys.size(); k++) {
+
+    _keys[k].found = false;
+
+    _keys[k].value = 0;
+
+    if (_keys[k].prefix.empty()) {
+
+      names[_keys[k].name] = k;
+    }
+  }
+
+  const char *line = _file.Data();
+
+  for (size_t n = 0; *line != '\0'; n++) {
+
+    const char *eol = strchr(line, '\n');
+
+    size_t length = strcspn(line, " \n");
+
+    if (length > 0 && line[length - 1] == ':') {
+
+      // a table header is followed by a value line with the same prefix
+      for (struct s_key &key : _keys) {
+
+        if (key.found || key.prefix.size() != length ||
+            strncmp(line, key.prefix.c_str(), length) != 0) {
+
+          continue;
+        }
+
+        const char *token;
+
+        for (size_t column = 1; (token = find_column(line, column)); column++) {
+
+          if (is_token(token, key.name)) {
+
+            key.line = n;
+
+            key.column = column;
+
+            key.found = true;
+
+            break;
+          }
+        }
+      }
+
+      // skip the value line
+      if (eol != nullptr && (eol = strchr(eol + 1, '\n')) != nullptr) {
+
+        ++n;
+      }
+    } else {
+
+      std::unordered_map<std::string_view, int>::iterator key =
+          names.find(std::string_view(line, length));
+
+      if (key != names.end()) {
+
+        _keys[key->second].line = n;
+
+        _keys[key->second].found = true;
+      }
+    }
+
+    if (eol == nullptr) {
+
+      break;
+    }
+
+    line = eol + 1;
+  }
+
+  _order.resize(_keys.size());
+
+  for (size_t k = 0; k < _keys.size(); k++) {
+
+    _order[k] = k;
+  }
+
+  std::sort(_order.begin(), _order.end(),
+            [this](int a, int b) { return _keys[a].line < _keys[b].line; });
+
+  return 0;
+}
+
+// Walks the newlines up to each remembered line, in line order, and checks
+// that the key is still there before parsing its value.
+int ProcTable::_lookup() {
+
+  if (_order.size() != _keys.size()) {
+
+    return 1;
+  }
+
+  const char *line = _file.Data();
+
+  size_t n = 0;
+
+  for (int k : _order) {
+
+    struct s_key &key = _keys[k];
+
+    if (!key.found) {
+
+      continue;
+    }
+
+    for (; n < key.line; n++) {
+
+      if ((line = strchr(line, '\n')) == nullptr) {
+
+        return 1;
+      }
+
+      ++line;
+    }
+
+    if (key.prefix.empty()) {
+
+      if (!is_token(line, key.name)) {
+
+        return 1;
+      }
+
+      key.value = strtoull(line + key.name.size(), nullptr, 10);
+
+      continue;
+    }
+
+    const char *token = find_column(line, key.column),
+               *values = strchr(line, '\n');
+
+    if (token == nullptr || !is_token(token, key.name) || values == nullptr ||
+        strncmp(++values, key.prefix.c_str(), key.prefix.size()) != 0 ||
+        (token = find_column(values, key.column)) == nullptr) {
+
+      return 1;
+    }
+
+    key.value = strtoull(token, nullptr, 10);
+  }
+
+  return 0;
+}
+
+int ProcTable::Read() {
+
+  if (_file.Read() != 0) {
+
+    return 1;
+  }
+
+  if (_lookup() != 0) {
+
+    _scan();
+
+    return _lookup();
+  }
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ *  @file   ProcTable.h
+ *  @brief  Linux /proc Key-Value Table Reader Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef PROCTABLE_H_
+#define PROCTABLE_H_
+
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <string>
+
+#include <string_view>
+
+#include <unordered_map>
+
+#include <vector>
+
+#include "ProcFile.h"
+#include "ReadBatch.h"
+
+// Reads a handful of counters out of a large /proc table. Two layouts are
+// understood: "name value" lines as in /proc/vmstat, and pairs of header
+// and value lines as in /proc/net/snmp, whose keys are written as
+// "Prefix:Name", e.g. "Tcp:RetransSegs". The line (and column) of every
+// key is remembered, so a read walks the newlines once and parses only the
+// wanted numbers. The full table is searched again only when a key has
+// moved.
+class ProcTable {
+
+public:
+  ProcTable();
+
+  int Open(const char *path,
+           ProcFile::Layout layout = ProcFile::Layout::Attribute);
+
+  int AddKey(const char *key);
+
+  int Prefetch(ReadBatch &batch);
+
+  int Read();
+
+  std::chrono::steady_clock::time_point ReadTime();
+
+  unsigned long long Value(int key);
+
+private:
+  struct s_key {
+    std::string prefix, name;
+    size_t line, column;
+    bool found;
+    unsigned long long value;
+  };
+
+  int _scan();
+
+  int _lookup();
+
+  ProcFile _file;
+
+  std::vector<struct s_key> _keys;
+
+  std::vector<int> _order;
+};
+
+inline int ProcTable::Prefetch(ReadBatch &batch) { return batch.Add(_file); }
+
+inline std::chrono::steady_clock::time_point ProcTable::ReadTime() {
+
+  return _file.ReadTime();
+}
+
+inline unsigned long long ProcTable::Value(int key) {
+
+  return _keys[key].value;
+}
+#endif // End of PROCTABLE_H_
@@ -0,0 +1,365 @@
+/**
+ *  @file   ProcessSampler.cpp
+ *  @brief  Linux Top Process Sampler Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "ProcessSampler.h"
+
+static const size_t MIN_HOT = 16;
+
+ProcessSampler::ProcessSampler(const char *root)
+    : _proc_fd(open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC)), _top(3),
+      _cursor(0), _hz(static_cast<float>(sysconf(_SC_CLK_TCK))),
+      _page_size(sysconf(_SC_PAGESIZE)) {}
+
+ProcessSampler::~ProcessSampler() {
+
+  for (const struct s_hot &hot : _hot) {
+
+    close(hot.fd);
+  }
+
+  if (_proc_fd >= 0) {
+
+    close(_proc_fd);
+  }
+}
+
+// "pid (comm) state ppid pgrp session tty_nr tpgid flags minflt cminflt
+// majflt cmajflt utime stime cutime cstime priority nice num_threads
+// itrealvalue starttime vsize rss ...", where comm may hold blanks and
+// parentheses of its own.
+int ProcessSampler::_parse(const char *data, size_t size,
+                           struct s_stat &stat) {
+
+  const char *open = static_cast<const char *>(memchr(data, '(', size)),
+             *close = static_cast<const char *>(memrchr(data, ')', size));
+
+  if (open == nullptr || close == nullptr || close < open) {
+
+    return 1;
+  }
+
+  LineScanner scanner(close + 1, data + size - close - 1);
+
+  const char *fields[22];
+
+  size_t lengths[22];
+
+  if (!scanner.NextLine() || scanner.Fields(fields, lengths, 22) != 22) {
+
+    return 1;
+  }
+
+  stat.name.assign(open + 1, close - open - 1);
+
+  stat.ticks = LineScanner::Decimal(fields[11], lengths[11]) +
+               LineScanner::Decimal(fields[12], lengths[12]);
+
+  stat.start = LineScanner::Decimal(fields[19], lengths[19]);
+
+  stat.memory = LineScanner::Decimal(fields[21], lengths[21]);
+
+  return 0;
+}
+
+ProcessSampler::s_task *ProcessSampler::_find(pid_t pid) {
+
+  std::vector<struct s_task>::iterator task = std::lower_bound(
+      _tasks.begin(), _tasks.end(), pid,
+      [](const struct s_task &task, pid_t pid) { return task.pid < pid; });
+
+  return task != _tasks.end() && task->pid == pid ? &*task : nullptr;
+}
+
+// Lists the pids afresh and merges them into the table, so the processes
+// that stay keep their counters as the baseline.
+int ProcessSampler::_list() {
+
+  alignas(struct dirent64) char buffer[32768];
+
+  std::vector<pid_t> pids;
+
+  pids.reserve(_tasks.size() + 64);
+
+  lseek(_proc_fd, 0, SEEK_SET);
+
+  long n;
+
+  while ((n = syscall(SYS_getdents64, _proc_fd, buffer, sizeof(buffer))) >
+         0) {
+
+    for (long offset = 0; offset < n;) {
+
+      struct dirent64 *entry =
+          reinterpret_cast<struct dirent64 *>(buffer + offset);
+
+      offset += entry->d_reclen;
+
+      if (entry->d_name[0] >= '0' && entry->d_name[0] <= '9') {
+
+        pids.push_back(
+            LineScanner::Decimal(entry->d_name, strlen(entry->d_name)));
+      }
+    }
+  }
+
+  std::sort(pids.begin(), pids.end());
+
+  std::vector<struct s_task> tasks;
+
+  tasks.reserve(pids.size());
+
+  std::vector<struct s_task>::const_iterator old = _tasks.begin();
+
+  for (pid_t pid : pids) {
+
+    for (; old != _tasks.end() && old->pid < pid; ++old) {
+    }
+
+    if (old != _tasks.end() && old->pid == pid) {
+
+      tasks.push_back(*old);
+    } else {
+
+      tasks.push_back({pid, 0, 0, {}, false});
+    }
+  }
+
+  _tasks.swap(tasks);
+
+  // hot processes that have gone are dropped when their read fails
+  for (const struct s_hot &hot : _hot) {
+
+    struct s_task *task = _find(hot.pid);
+
+    if (task != nullptr) {
+
+      task->hot = true;
+    }
+  }
+
+  return n < 0 ? 1 : 0;
+}
+
+// Reads the stat of a process that is not hot through a throw-away
+// descriptor: one descriptor per process would exhaust the fd limit.
+int ProcessSampler::_visit(struct s_task &task,
+                           std::chrono::steady_clock::time_point now,
+                           float &cpu) {
+
+  char path[32], buffer[1024];
+
+  snprintf(path, sizeof(path), "%d/stat", task.pid);
+
+  int fd = openat(_proc_fd, path, O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0) {
+
+    return 1;
+  }
+
+  ssize_t n = read(fd, buffer, sizeof(buffer));
+
+  close(fd);
+
+  struct s_stat stat;
+
+  if (n <= 0 || _parse(buffer, n, stat) != 0) {
+
+    return 1;
+  }
+
+  cpu = 0.0f;
+
+  // a reused pid starts over
+  if (task.start == stat.start && task.visited.time_since_epoch().count() > 0 &&
+      now > task.visited) {
+
+    cpu = counter_delta(stat.ticks, task.ticks) / _hz /
+          std::chrono::duration<float>(now - task.visited).count();
+  }
+
+  task.ticks = stat.ticks;
+
+  task.start = stat.start;
+
+  task.visited = now;
+
+  return 0;
+}
+
+int ProcessSampler::_read_hot(struct s_hot &hot,
+                              std::chrono::steady_clock::time_point now) {
+
+  char buffer[1024];
+
+  ssize_t n = pread(hot.fd, buffer, sizeof(buffer), 0);
+
+  struct s_stat stat;
+
+  // the descriptor stays with the process, a reused pid reads as gone
+  if (n <= 0 || _parse(buffer, n, stat) != 0) {
+
+    return 1;
+  }
+
+  hot.cpu = now > hot.read
+                ? counter_delta(stat.ticks, hot.stat.ticks) / _hz /
+                      std::chrono::duration<float>(now - hot.read).count()
+                : 0.0f;
+
+  hot.stat = stat;
+
+  hot.read = now;
+
+  return 0;
+}
+
+// Opens the stat of a process that turned out busy, taking the place of
+// the quietest hot process once the hot set is full.
+int ProcessSampler::_promote(pid_t pid, float cpu,
+                             std::chrono::steady_clock::time_point now) {
+
+  size_t capacity = std::max(MIN_HOT, 4 * _top);
+
+  std::vector<struct s_hot>::iterator quietest =
+      std::min_element(_hot.begin(), _hot.end(),
+                       [](const struct s_hot &a, const struct s_hot &b) {
+                         return a.cpu < b.cpu;
+                       });
+
+  if (_hot.size() >= capacity && quietest->cpu >= cpu) {
+
+    return 1;
+  }
+
+  char path[32];
+
+  snprintf(path, sizeof(path), "%d/stat", pid);
+
+  struct s_hot hot = {pid, openat(_proc_fd, path, O_RDONLY | O_CLOEXEC)};
+
+  if (hot.fd < 0) {
+
+    return 1;
+  }
+
+  if (_read_hot(hot, now) != 0) {
+
+    close(hot.fd);
+
+    return 1;
+  }
+
+  hot.cpu = cpu;
+
+  if (_hot.size() >= capacity) {
+
+    struct s_task *task = _find(quietest->pid);
+
+    if (task != nullptr) {
+
+      task->hot = false;
+
+      // its counters moved on while it was hot
+      task->visited = {};
+    }
+
+    close(quietest->fd);
+
+    *quietest = hot;
+  } else {
+
+    _hot.push_back(hot);
+  }
+
+  _find(pid)->hot = true;
+
+  return 0;
+}
+
+// The hot processes are re-read first, then a slice of the others is
+// visited; the busy ones among those join the hot set right away.
+int ProcessSampler::Sample(std::vector<struct s_process> &processes) {
+
+  processes.clear();
+
+  if (_proc_fd < 0) {
+
+    return 1;
+  }
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  _hot.erase(std::remove_if(_hot.begin(), _hot.end(),
+                            [&](struct s_hot &hot) {
+                              if (_read_hot(hot, now) == 0) {
+
+                                return false;
+                              }
+
+                              struct s_task *task = _find(hot.pid);
+
+                              if (task != nullptr) {
+
+                                task->hot = false;
+                              }
+
+                              close(hot.fd);
+
+                              return true;
+                            }),
+             _hot.end());
+
+  if (_cursor >= _tasks.size()) {
+
+    _list();
+
+    _cursor = 0;
+  }
+
+  // every process is visited at least once in eight calls; small tables
+  // are sliced as well, a whole pass costs as much as a full rescan
+  size_t batch = (_tasks.size() + 7) / 8;
+
+  for (; _cursor < _tasks.size() && batch > 0; _cursor++) {
+
+    struct s_task &task = _tasks[_cursor];
+
+    float cpu;
+
+    if (task.hot) {
+
+      continue;
+    }
+
+    --batch;
+
+    if (_visit(task, now, cpu) == 0 && cpu > 0.0f) {
+
+      _promote(task.pid, cpu, now);
+    }
+  }
+
+  size_t top = std::min(_top, _hot.size());
+
+  std::partial_sort(_hot.begin(), _hot.begin() + top, _hot.end(),
+                    [](const struct s_hot &a, const struct s_hot &b) {
+                      return a.cpu > b.cpu;
+                    });
+
+  for (size_t n = 0; n < top && _hot[n].cpu > 0.0f; n++) {
+
+    const struct s_hot &hot = _hot[n];
+
+    processes.push_back(
+        {hot.pid, hot.stat.name, hot.cpu, hot.stat.memory * _page_size});
+  }
+
+  return 0;
+}
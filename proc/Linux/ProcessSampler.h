@@ -0,0 +1,116 @@
+/**
+ *  @file   ProcessSampler.h
+ *  @brief  Linux Top Process Sampler Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef PROCESSSAMPLER_H_
+#define PROCESSSAMPLER_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <string>
+
+#include <vector>
+
+#include "Counter.h"
+#include "LineScanner.h"
+
+// Ranks the processes by CPU usage. The pids are listed with getdents64(2)
+// once per pass over the table, and every Sample() visits a slice of them,
+// opening, reading and closing /proc/[pid]/stat, so that the whole table
+// is seen within eight calls. The processes that were busy at their last
+// visit are kept hot: their stat stays open and is re-read on every call,
+// and the top-N come out of them with a partial sort.
+class ProcessSampler {
+
+public:
+  struct s_process {
+    pid_t pid;
+    std::string name;
+    float cpu;
+    unsigned long memory;
+  };
+
+  ProcessSampler(const char *root = "/proc");
+
+  ~ProcessSampler();
+
+  ProcessSampler(const ProcessSampler &) = delete;
+
+  ProcessSampler &operator=(const ProcessSampler &) = delete;
+
+  int SetTop(size_t top);
+
+  int Sample(std::vector<struct s_process> &processes);
+
+private:
+  struct s_stat {
+    std::string name;
+    unsigned long long ticks, start;
+    unsigned long memory;
+  };
+
+  struct s_task {
+    pid_t pid;
+    unsigned long long ticks, start;
+    std::chrono::steady_clock::time_point visited;
+    bool hot;
+  };
+
+  struct s_hot {
+    pid_t pid;
+    int fd;
+    struct s_stat stat;
+    std::chrono::steady_clock::time_point read;
+    float cpu;
+  };
+
+  int _list();
+
+  int _visit(struct s_task &task, std::chrono::steady_clock::time_point now,
+             float &cpu);
+
+  int _promote(pid_t pid, float cpu, std::chrono::steady_clock::time_point now);
+
+  int _read_hot(struct s_hot &hot, std::chrono::steady_clock::time_point now);
+
+  static int _parse(const char *data, size_t size, struct s_stat &stat);
+
+  struct s_task *_find(pid_t pid);
+
+  int _proc_fd;
+
+  std::vector<struct s_task> _tasks;
+
+  std::vector<struct s_hot> _hot;
+
+  size_t _top, _cursor;
+
+  float _hz;
+
+  unsigned long _page_size;
+};
+
+inline int ProcessSampler::SetTop(size_t top) {
+
+  _top = top;
+
+  return 0;
+}
+#endif // End of PROCESSSAMPLER_H_
@@ -0,0 +1,273 @@
+/**
+ *  @file   ReadBatch.cpp
+ *  @brief  Linux io_uring Batched File Reader Class Implementation
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include "ReadBatch.h"
+
+template <typename T> static T *ring_field(void *ring, unsigned offset) {
+
+  return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+static void *map_ring(int fd, size_t length, off_t offset) {
+
+  void *ring = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, offset);
+
+  return ring == MAP_FAILED ? nullptr : ring;
+}
+
+ReadBatch::ReadBatch()
+    : _fd(-1), _sq_ring(nullptr), _cq_ring(nullptr), _sq_length(0),
+      _cq_length(0), _sqes_length(0), _sqes(nullptr), _entries(0) {}
+
+ReadBatch::~ReadBatch() { Close(); }
+
+int ReadBatch::Open(unsigned entries) {
+
+  Close();
+
+  struct io_uring_params params = {};
+
+  _fd = syscall(__NR_io_uring_setup, entries, &params);
+
+  if (_fd < 0) {
+
+    return 1;
+  }
+
+  _entries = params.sq_entries;
+
+  _sq_length = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+
+  _cq_length =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+  _sqes_length = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  _sq_ring = map_ring(_fd, _sq_length, IORING_OFF_SQ_RING);
+
+  _cq_ring = map_ring(_fd, _cq_length, IORING_OFF_CQ_RING);
+
+  _sqes = static_cast<struct io_uring_sqe *>(
+      map_ring(_fd, _sqes_length, IORING_OFF_SQES));
+
+  if (_sq_ring == nullptr || _cq_ring == nullptr || _sqes == nullptr) {
+
+    Close();
+
+    return 1;
+  }
+
+  _sq_tail = ring_field<unsigned>(_sq_ring, params.sq_off.tail);
+
+  _sq_mask = ring_field<unsigned>(_sq_ring, params.sq_off.ring_mask);
+
+  _sq_array = ring_field<unsigned>(_sq_ring, params.sq_off.array);
+
+  _cq_head = ring_field<unsigned>(_cq_ring, params.cq_off.head);
+
+  _cq_tail = ring_field<unsigned>(_cq_ring, params.cq_off.tail);
+
+  _cq_mask = ring_field<unsigned>(_cq_ring, params.cq_off.ring_mask);
+
+  _cqes = ring_field<struct io_uring_cqe>(_cq_ring, params.cq_off.cqes);
+
+  return 0;
+}
+
+void ReadBatch::Close() {
+
+  if (_sqes != nullptr) {
+
+    munmap(_sqes, _sqes_length);
+  }
+
+  if (_cq_ring != nullptr) {
+
+    munmap(_cq_ring, _cq_length);
+  }
+
+  if (_sq_ring != nullptr) {
+
+    munmap(_sq_ring, _sq_length);
+  }
+
+  _sqes = nullptr;
+
+  _sq_ring = _cq_ring = nullptr;
+
+  if (_fd >= 0) {
+
+    close(_fd);
+
+    _fd = -1;
+  }
+
+  _files.clear();
+}
+
+int ReadBatch::Add(ProcFile &file) {
+
+  if (_fd < 0) {
+
+    return 1;
+  }
+
+  file._prefetched = false;
+
+  if (file._reopen() != 0) {
+
+    return 1;
+  }
+
+  _files.push_back(&file);
+
+  return 0;
+}
+
+// Fills one submission entry per pending file, each reading on at the end
+// of what the file holds so far, waits for all of them in the same call
+// and keeps the files that have more to read.
+int ReadBatch::_enter(std::vector<ProcFile *> &files) {
+
+  unsigned tail = *_sq_tail;
+
+  for (size_t n = 0; n < files.size(); n++) {
+
+    ProcFile *file = files[n];
+
+    unsigned index = (tail + n) & *_sq_mask;
+
+    struct io_uring_sqe *sqe = &_sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+
+    sqe->opcode = IORING_OP_READ;
+
+    // procfs and sysfs cannot read without blocking, so skip the attempt
+    // and go straight to an io-wq worker
+    sqe->flags = IOSQE_ASYNC;
+
+    sqe->fd = file->_fd;
+
+    sqe->off = file->_size;
+
+    sqe->addr = reinterpret_cast<unsigned long>(file->_buffer.get() +
+                                                file->_size);
+
+    sqe->len = file->_capacity - file->_size;
+
+    sqe->user_data = n;
+
+    _sq_array[index] = index;
+  }
+
+  __atomic_store_n(_sq_tail, tail + files.size(), __ATOMIC_RELEASE);
+
+  int submitted;
+
+  do {
+
+    submitted = syscall(__NR_io_uring_enter, _fd, files.size(), files.size(),
+                        IORING_ENTER_GETEVENTS, nullptr, 0);
+  } while (submitted < 0 && errno == EINTR);
+
+  if (submitted < 0) {
+
+    Close();
+
+    files.clear();
+
+    return 1;
+  }
+
+  std::vector<ProcFile *> pending;
+
+  unsigned head = *_cq_head, reaped = 0;
+
+  bool unsupported = false;
+
+  while (reaped < static_cast<unsigned>(submitted)) {
+
+    unsigned ready = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+
+    if (head == ready) {
+
+      syscall(__NR_io_uring_enter, _fd, 0, 1, IORING_ENTER_GETEVENTS,
+              nullptr, 0);
+
+      continue;
+    }
+
+    for (; head != ready; head++, reaped++) {
+
+      struct io_uring_cqe *cqe = &_cqes[head & *_cq_mask];
+
+      ProcFile *file = files[cqe->user_data];
+
+      // IORING_OP_READ is 5.6, earlier kernels reject it as invalid and
+      // the file is left to read itself
+      if (cqe->res == -EINVAL) {
+
+        unsupported = true;
+      } else if (file->_complete(cqe->res)) {
+
+        pending.push_back(file);
+      }
+    }
+
+    __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+  }
+
+  files.swap(pending);
+
+  if (unsupported) {
+
+    Close();
+
+    files.clear();
+  }
+
+  return unsupported ? 1 : 0;
+}
+
+// An attribute takes a single round once its buffer fits it; a table takes
+// a round per page it holds and one more for the empty read that ends it.
+// The rounds are shared by all files, so a probe costs one io_uring_enter(2)
+// per page of the longest table plus one.
+int ReadBatch::Submit() {
+
+  std::chrono::steady_clock::time_point read = std::chrono::steady_clock::now();
+
+  int error = 0;
+
+  for (size_t first = 0; _fd >= 0 && first < _files.size();
+       first += _entries) {
+
+    std::vector<ProcFile *> files(
+        _files.begin() + first,
+        _files.begin() + std::min<size_t>(_files.size(), first + _entries));
+
+    for (ProcFile *file : files) {
+
+      file->_read = read;
+
+      file->_size = 0;
+    }
+
+    while (!files.empty()) {
+
+      error |= _enter(files);
+    }
+  }
+
+  _files.clear();
+
+  return error;
+}
@@ -0,0 +1,77 @@
+/**
+ *  @file   ReadBatch.h
+ *  @brief  Linux io_uring Batched File Reader Class Definition
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#ifndef READBATCH_H_
+#define READBATCH_H_
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <chrono>
+
+#include <vector>
+
+#include "ProcFile.h"
+
+// Reads a set of ProcFiles together through io_uring: Add() queues the
+// files a probe is about to read, Submit() hands all of them to the kernel
+// in one io_uring_enter(2) and waits for every read to complete. Each file
+// then serves its next Read() from the batch. Until Open() succeeds
+// (kernels before 5.6, io_uring disabled by sysctl or seccomp) Add()
+// refuses the files and they read themselves with pread(2) as before.
+class ReadBatch {
+
+public:
+  ReadBatch();
+
+  ~ReadBatch();
+
+  ReadBatch(const ReadBatch &) = delete;
+
+  ReadBatch &operator=(const ReadBatch &) = delete;
+
+  int Open(unsigned entries = 32);
+
+  void Close();
+
+  bool good();
+
+  int Add(ProcFile &file);
+
+  int Submit();
+
+private:
+  int _enter(std::vector<ProcFile *> &files);
+
+  int _fd;
+
+  void *_sq_ring, *_cq_ring;
+
+  size_t _sq_length, _cq_length, _sqes_length;
+
+  struct io_uring_sqe *_sqes;
+
+  struct io_uring_cqe *_cqes;
+
+  unsigned *_sq_tail, *_sq_mask, *_sq_array, *_cq_head, *_cq_tail, *_cq_mask;
+
+  unsigned _entries;
+
+  std::vector<ProcFile *> _files;
+};
+
+inline bool ReadBatch::good() { return _fd >= 0; }
+#endif // End of READBATCH_H_
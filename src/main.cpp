@@ -45,6 +45,26 @@ int HandleCPU();
 
 int HandleBattery();
 
+int HandleStale();
+
+int HandlePressure();
+
+int HandleIOLoad();
+
+int HandleCgroups();
+
+int HandleProcesses();
+
+int HandleSensors();
+
+int HandleInterrupts();
+
+int HandleEfficiency();
+
+int HandleVM();
+
+int HandleTCP();
+
 WindowEvents EventHandler(WindowEvent *e);
 
 ApplicationManager *amanager = nullptr;
@@ -53,12 +73,32 @@ SettingsManager *smanager = nullptr;
 
 ProcManager *pmanager = nullptr;
 
+const ProcManager::s_sample *sample = nullptr;
+
 WindowManager *wmanager = nullptr;
 
 ManagedWindow *mwindow = nullptr;
 
 int timeout;
 
+int percore;
+
+int cgroups;
+
+int processes;
+
+int burst;
+
+int sensors;
+
+int interrupts;
+
+int perf;
+
+int vm;
+
+int tcp;
+
 time_t t;
 
 struct tm *tm_s;
@@ -99,10 +139,83 @@ int main(int argc, char *argv[], char **envp) {
 
   pmanager->SetIO(smanager->GetOptionForKey("io").c_str());
 
-  pmanager->SetProcMask(ProcManager::Masks::CPU | ProcManager::Masks::Mem |
-                        ProcManager::Masks::Disk | ProcManager::Masks::Eth |
-                        ProcManager::Masks::IO | ProcManager::Masks::Users |
-                        ProcManager::Masks::Battery);
+  cgroups = atoi(smanager->GetOptionForKey("cgroups").c_str());
+
+  pmanager->SetCgroups(cgroups);
+
+  processes = atoi(smanager->GetOptionForKey("processes").c_str());
+
+  pmanager->SetProcesses(processes);
+
+  burst = std::clamp(atoi(smanager->GetOptionForKey("burst").c_str()), 0, 100);
+
+  sensors = atoi(smanager->GetOptionForKey("sensors").c_str());
+
+  interrupts = atoi(smanager->GetOptionForKey("interrupts").c_str());
+
+  perf = atoi(smanager->GetOptionForKey("perf").c_str());
+
+  vm = atoi(smanager->GetOptionForKey("vm").c_str());
+
+  tcp = atoi(smanager->GetOptionForKey("tcp").c_str());
+
+  pmanager->SetUring(atoi(smanager->GetOptionForKey("uring").c_str()) != 0);
+
+  pmanager->SetProcMask(
+      (ProcManager::Masks::CPU | ProcManager::Masks::Mem |
+       ProcManager::Masks::Disk | ProcManager::Masks::Eth |
+       ProcManager::Masks::IO | ProcManager::Masks::Users |
+       ProcManager::Masks::Battery | ProcManager::Masks::Pressure) |
+      (cgroups > 0 ? ProcManager::Masks::Cgroups
+                   : ProcManager::Masks::Ignore) |
+      (processes > 0 ? ProcManager::Masks::Processes
+                     : ProcManager::Masks::Ignore) |
+      (burst > 0 ? ProcManager::Masks::Burst : ProcManager::Masks::Ignore) |
+      (sensors > 0 ? ProcManager::Masks::Sensors
+                   : ProcManager::Masks::Ignore) |
+      (interrupts > 0 ? ProcManager::Masks::Interrupts
+                      : ProcManager::Masks::Ignore) |
+      (perf > 0 ? ProcManager::Masks::Perf : ProcManager::Masks::Ignore) |
+      (vm > 0 ? ProcManager::Masks::VM : ProcManager::Masks::Ignore) |
+      (tcp > 0 ? ProcManager::Masks::TCP : ProcManager::Masks::Ignore));
+
+  timeout = atoi(smanager->GetOptionForKey("timeout").c_str());
+
+  if (timeout <= 0) {
+
+    timeout = 2000;
+  }
+
+  const std::pair<const char *, ProcManager::Masks> intervals[] = {
+      {"timeout_battery", ProcManager::Masks::Battery},
+      {"timeout_cgroups", ProcManager::Masks::Cgroups},
+      {"timeout_cpu", ProcManager::Masks::CPU},
+      {"timeout_disk", ProcManager::Masks::Disk},
+      {"timeout_eth", ProcManager::Masks::Eth},
+      {"timeout_interrupts", ProcManager::Masks::Interrupts},
+      {"timeout_io", ProcManager::Masks::IO},
+      {"timeout_mem", ProcManager::Masks::Mem},
+      {"timeout_perf", ProcManager::Masks::Perf},
+      {"timeout_pressure", ProcManager::Masks::Pressure},
+      {"timeout_processes", ProcManager::Masks::Processes},
+      {"timeout_sensors", ProcManager::Masks::Sensors},
+      {"timeout_tcp", ProcManager::Masks::TCP},
+      {"timeout_users", ProcManager::Masks::Users},
+      {"timeout_vm", ProcManager::Masks::VM}};
+
+  for (const std::pair<const char *, ProcManager::Masks> &interval :
+       intervals) {
+
+    int msec = atoi(smanager->GetOptionForKey(interval.first).c_str());
+
+    pmanager->SetInterval(interval.second, msec > 0 ? msec : timeout);
+  }
+
+  // $burst is in samples per second
+  if (burst > 0) {
+
+    pmanager->SetInterval(ProcManager::Masks::Burst, 1000 / burst);
+  }
 
   pmanager->Probe();
 
@@ -158,7 +271,7 @@ int main(int argc, char *argv[], char **envp) {
 
   delete icon;
 
-  timeout = atoi(smanager->GetOptionForKey("timeout").c_str());
+  percore = atoi(smanager->GetOptionForKey("percore").c_str());
 
   amanager->SetTimeout(1000 / FRAME_RATE);
 
@@ -191,16 +304,17 @@ int SignalHandler(int sig) {
 
 int CallbackHandler() {
 
-  static unsigned long tick = 0;
-
   if (mwindow->IsPaused()) {
 
     return 0;
   }
 
-  if (tick++ % (timeout / (1000 / FRAME_RATE)) == 0) {
+  sample = &pmanager->Snapshot();
+
+  // nothing to draw before the first probe is in
+  if (sample->timestamp.time_since_epoch().count() == 0) {
 
-    pmanager->Probe();
+    return 0;
   }
 
   t = time(NULL);
@@ -225,6 +339,26 @@ int CallbackHandler() {
 
   HandleBattery();
 
+  HandlePressure();
+
+  HandleIOLoad();
+
+  HandleEfficiency();
+
+  HandleVM();
+
+  HandleTCP();
+
+  HandleSensors();
+
+  HandleInterrupts();
+
+  HandleCgroups();
+
+  HandleProcesses();
+
+  HandleStale();
+
   mwindow->RenderLayer();
 
   HandleTime();
@@ -267,7 +401,7 @@ int HandleCPU() {
 
   static float cpu[3] = {0.0f, 0.0f, 0.0f};
 
-  float cpu_in[3] = {pmanager->cpu.sys, pmanager->cpu.user, pmanager->cpu.nice},
+  float cpu_in[3] = {sample->cpu.sys, sample->cpu.user, sample->cpu.nice},
         sum = 0.0f, r1, r2;
 
   for (int i = 0; i < 3; i++) {
@@ -308,6 +442,21 @@ int HandleCPU() {
     mwindow->DrawCircle(CEN_X, CEN_Y, R0, roundf(r2), "rgba:af/ae/c4/bb");
   }
 
+  if (percore) {
+
+    static std::vector<float> cores;
+
+    cores.resize(sample->cores.size(), 0.0f);
+
+    for (size_t n = 0; n < cores.size(); n++) {
+
+      cores[n] = 0.9f * cores[n] + 0.1f * sample->cores[n];
+    }
+
+    mwindow->DrawSegments(CEN_X, CEN_Y, roundf(R1 - CEN_X * 1.0 / 32.0), R1,
+                          cores, "rgba:ff/8c/00/bb");
+  }
+
   return 0;
 }
 
@@ -367,10 +516,7 @@ int HandleIO() {
 
   static float io[2] = {0, 0};
 
-  float io_in[2] = {1000.0f * static_cast<float>(pmanager->io.read) /
-                        static_cast<float>(timeout),
-                    1000.0f * static_cast<float>(pmanager->io.write) /
-                        static_cast<float>(timeout)};
+  float io_in[2] = {sample->io.read, sample->io.write};
 
   for (int i = 0; i < 2; i++) {
 
@@ -384,6 +530,25 @@ int HandleIO() {
                    180.0 - std::clamp(io[OUT], 0.0f, 90.0f), 180.0,
                    "rgba:66/ff/4f/bb");
 
+  // the fastest burst since the previous sample ticks on top of the average
+  if (burst > 0) {
+
+    float scale = 90.0f / (20.0f * 1024.0f * 1024.0f),
+          peak[2] = {scale * sample->burst.read.max,
+                     scale * sample->burst.write.max},
+          angle[2] = {180.0f + std::min(peak[IN], 89.0f),
+                      180.0f - std::min(peak[OUT], 89.0f)};
+
+    for (int i = 0; i < 2; i++) {
+
+      if (peak[i] >= 1.0f) {
+
+        mwindow->DrawArc(CEN_X, CEN_Y, R2, R3, angle[i] - 1.0f,
+                         angle[i] + 1.0f, "rgba:ff/ff/ff/dd");
+      }
+    }
+  }
+
   return 0;
 }
 
@@ -391,10 +556,7 @@ int HandleEth() {
 
   static float eth[2] = {0, 0};
 
-  float eth_in[2] = {1000.0f * static_cast<float>(pmanager->eth.sent) /
-                         static_cast<float>(timeout),
-                     1000.0f * static_cast<float>(pmanager->eth.received) /
-                         static_cast<float>(timeout)};
+  float eth_in[2] = {sample->eth.sent, sample->eth.received};
 
   for (int i = 0; i < 2; i++) {
 
@@ -408,57 +570,67 @@ int HandleEth() {
                    360.0 - std::clamp(eth[RECV], 0.0f, 90.0f), 360.0,
                    "rgba:39/9c/c4/bb");
 
+  if (burst > 0) {
+
+    float scale = 90.0f / (10.0f * 1024.0f * 1024.0f),
+          peak[2] = {scale * sample->burst.sent.max,
+                     scale * sample->burst.received.max},
+          angle[2] = {std::min(peak[SENT], 89.0f),
+                      360.0f - std::min(peak[RECV], 89.0f)};
+
+    for (int i = 0; i < 2; i++) {
+
+      if (peak[i] >= 1.0f) {
+
+        mwindow->DrawArc(CEN_X, CEN_Y, R2, R3, angle[i] - 1.0f,
+                         angle[i] + 1.0f, "rgba:ff/ff/ff/dd");
+      }
+    }
+  }
+
   return 0;
 }
 
 int HandleMem() {
 
-  static float free = 180.0f * pmanager->memory.freeram /
-                      pmanager->memory.totalram,
-               buffer = 180.0f * pmanager->memory.bufferram /
-                        pmanager->memory.totalram,
-               shared = 180.0f * pmanager->memory.sharedram /
-                        pmanager->memory.totalram,
-               kernel =
-                   180.0f *
-                   (pmanager->memory.totalram - pmanager->memory.freeram -
-                    pmanager->memory.bufferram - pmanager->memory.sharedram) /
-                   pmanager->memory.totalram;
+  if (sample->memory.total == 0) {
+
+    return 0;
+  }
 
-  free = 0.9f * free +
-         0.1f * 180.0f * pmanager->memory.freeram / pmanager->memory.totalram;
+  float total = static_cast<float>(sample->memory.total),
+        available =
+            std::min(static_cast<float>(sample->memory.available), total),
+        free = std::min(static_cast<float>(sample->memory.free), available),
+        buffers = std::min(static_cast<float>(sample->memory.buffers),
+                           available - free);
 
-  buffer = 0.9f * buffer + 0.1f * 180.0f * pmanager->memory.bufferram /
-                               pmanager->memory.totalram;
+  // what MemAvailable counts on top of free memory and buffers is cache the
+  // kernel can drop, it is not in use
+  float mem_in[3] = {180.0f * (total - available) / total,
+                     180.0f * buffers / total,
+                     180.0f * (available - free - buffers) / total};
 
-  shared = 0.9f * shared + 0.1f * 180.0f * pmanager->memory.sharedram /
-                               pmanager->memory.totalram;
+  static float mem[3] = {mem_in[USED], mem_in[BUFFERS], mem_in[CACHE]};
 
-  kernel = 0.9f * kernel +
-           0.1f * 180.0f *
-               (pmanager->memory.totalram - pmanager->memory.freeram -
-                pmanager->memory.bufferram - pmanager->memory.sharedram) /
-               pmanager->memory.totalram;
+  static const char *colors[3] = {"rgba:aa/00/00/bb", "rgba:00/aa/00/bb",
+                                  "rgba:00/00/ff/bb"};
 
-  float val0 = 0.0f, val1 = free;
+  float val0 = 0.0f, val1;
 
-  if (val1 > 0.0f)
-    mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, val0, val1, "rgba:aa/00/00/bb");
+  for (int i = 0; i < 3; i++) {
 
-  val0 = val1;
-  val1 += buffer;
+    mem[i] = 0.9f * mem[i] + 0.1f * mem_in[i];
 
-  if (val1 > 0.0f)
-    mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, val0, val1, "rgba:00/aa/00/bb");
+    val1 = val0 + mem[i];
 
-  val0 = val1;
-  val1 += shared;
+    if (val1 > val0) {
 
-  if (val1 > 0.0f)
-    mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, val0, val1, "rgba:00/00/ff/bb");
+      mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, val0, val1, colors[i]);
+    }
 
-  val0 = val1;
-  val1 += kernel;
+    val0 = val1;
+  }
 
   mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, val0, 180.0, "rgba:aa/aa/00/bb");
 
@@ -467,17 +639,43 @@ int HandleMem() {
 
 int HandleDisk() {
 
-  static float free = static_cast<float>(pmanager->disk.f_bfree) /
-                      static_cast<float>(pmanager->disk.f_blocks);
+  static std::vector<float> free;
 
-  free = 0.9f * free + 0.1f * static_cast<float>(pmanager->disk.f_bfree) /
-                           static_cast<float>(pmanager->disk.f_blocks);
+  size_t ndisks = sample->disks.size();
 
-  mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, 180, 180 + 180.0f * free,
-                   "rgba:bd/56/90/bb");
+  if (ndisks == 0) {
 
-  mwindow->DrawArc(CEN_X, CEN_Y, R1, R2, 180.0f + 180.0f * free, 360,
-                   "rgba:a2/2e/d5/bb");
+    return 0;
+  }
+
+  float width = (R2 - R1) / ndisks;
+
+  for (size_t n = 0; n < ndisks; n++) {
+
+    if (sample->disks[n].blocks == 0) {
+
+      continue;
+    }
+
+    float value = static_cast<float>(sample->disks[n].bfree) /
+                  static_cast<float>(sample->disks[n].blocks);
+
+    if (n >= free.size()) {
+
+      free.resize(n + 1, value);
+    }
+
+    free[n] = 0.9f * free[n] + 0.1f * value;
+
+    float r1 = R1 + n * width, r2 = r1 + width;
+
+    mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 180, 180 + 180.0f * free[n],
+                     sample->disks[n].stale ? "rgba:88/88/88/bb"
+                                            : "rgba:bd/56/90/bb");
+
+    mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 180.0f + 180.0f * free[n], 360,
+                     "rgba:a2/2e/d5/bb");
+  }
 
   mwindow->RenderLayer();
 
@@ -486,11 +684,11 @@ int HandleDisk() {
 
 int HandleUser() {
 
-  if (!pmanager->users.empty()) {
-    mwindow->DrawText(CEN_X, CEN_Y - 8, pmanager->users.front(),
+  if (!sample->users.empty()) {
+    mwindow->DrawText(CEN_X, CEN_Y - 8, sample->users.front(),
                       "rgba:aa/aa/aa/bb", TEXT::ALIGN::CENTER);
 
-    mwindow->DrawText(CEN_X, CEN_Y + 24, std::to_string(pmanager->users.size()),
+    mwindow->DrawText(CEN_X, CEN_Y + 24, std::to_string(sample->users.size()),
                       "rgba:aa/aa/aa/bb", TEXT::ALIGN::CENTER);
   }
 
@@ -504,11 +702,11 @@ int HandleBattery() {
   static const char *colors[] = {"", "rgba:dd/dd/dd/dd", "rgba:ff/a5/00/dd",
                                  "rgba:ee/00/00/dd"};
 
-  if (pmanager->battery.powerstate != ProcManager::PowerStates::Unknown) {
+  if (sample->battery.powerstate != ProcManager::PowerStates::Unknown) {
 
     float start = CEN_X - width / 2;
 
-    float length = pmanager->battery.level * width;
+    float length = sample->battery.level * width;
 
     if (length > 0) {
 
@@ -523,9 +721,333 @@ int HandleBattery() {
       length = width - length;
 
       mwindow->DrawLine(start, CEN_Y + 56, start + length, CEN_Y + 56, 5,
-                        colors[(int)pmanager->battery.powerstate]);
+                        colors[(int)sample->battery.powerstate]);
+    }
+  }
+
+  return 0;
+}
+
+int HandlePressure() {
+
+  static float pressure[3][2] = {{0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}};
+
+  const ProcManager::s_stall *stalls[] = {&sample->pressure.cpu,
+                                          &sample->pressure.memory,
+                                          &sample->pressure.io};
+
+  float width = (R4 - R3) / 3.0f;
+
+  for (int n = 0; n < 3; n++) {
+
+    pressure[n][0] = 0.5f * pressure[n][0] + 0.5f * stalls[n]->some;
+
+    pressure[n][1] = 0.5f * pressure[n][1] + 0.5f * stalls[n]->full;
+
+    float r1 = R3 + n * width, r2 = r1 + width;
+
+    if (pressure[n][0] > 0.005f) {
+
+      mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 135.0f - 90.0f * pressure[n][0],
+                       135.0f, "rgba:ff/a5/00/bb");
+    }
+
+    if (pressure[n][1] > 0.005f) {
+
+      mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 135.0f - 90.0f * pressure[n][1],
+                       135.0f, "rgba:ee/00/00/bb");
+    }
+  }
+
+  return 0;
+}
+
+// Utilization, queue depth and await of the busiest disk as three thin arcs
+// between R3 and R4, growing from 225 degrees towards the pressure gauge.
+// Queue depth and await saturate, reaching half way at a depth of 1 and an
+// await of 10 ms.
+int HandleIOLoad() {
+
+  static float load[3] = {0.0f, 0.0f, 0.0f};
+
+  float in[3] = {sample->io.utilization,
+                 sample->io.queue / (1.0f + sample->io.queue),
+                 sample->io.await / (10.0f + sample->io.await)};
+
+  const char *colors[] = {"rgba:ff/2c/1c/bb", "rgba:ff/a5/00/bb",
+                          "rgba:c0/60/ff/bb"};
+
+  float width = (R4 - R3) / 3.0f;
+
+  for (int n = 0; n < 3; n++) {
+
+    load[n] = 0.5f * load[n] + 0.5f * std::clamp(in[n], 0.0f, 1.0f);
+
+    float r1 = R3 + n * width, r2 = r1 + width;
+
+    if (load[n] > 0.005f) {
+
+      mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 225.0f - 90.0f * load[n], 225.0f,
+                       colors[n]);
     }
   }
 
   return 0;
 }
+
+// Instructions per cycle, context switches and CPU migrations per core as
+// three thin arcs between R3 and R4, growing from 315 degrees towards the
+// disk gauge. They reach half way at an IPC of 1, 10000 switches and 100
+// migrations a second per core; without a PMU the IPC arc stays empty.
+int HandleEfficiency() {
+
+  if (perf <= 0 || !sample->perf.software) {
+
+    return 0;
+  }
+
+  static float efficiency[3] = {0.0f, 0.0f, 0.0f};
+
+  float ncores = std::max(static_cast<float>(sample->cores.size()), 1.0f),
+        switches = sample->perf.switches / ncores,
+        migrations = sample->perf.migrations / ncores;
+
+  float in[3] = {sample->perf.ipc / (1.0f + sample->perf.ipc),
+                 switches / (10000.0f + switches),
+                 migrations / (100.0f + migrations)};
+
+  const char *colors[] = {"rgba:66/ff/4f/bb", "rgba:ff/a5/00/bb",
+                          "rgba:c0/60/ff/bb"};
+
+  float width = (R4 - R3) / 3.0f;
+
+  for (int n = 0; n < 3; n++) {
+
+    efficiency[n] = 0.5f * efficiency[n] + 0.5f * std::clamp(in[n], 0.0f, 1.0f);
+
+    float r1 = R3 + n * width, r2 = r1 + width;
+
+    if (efficiency[n] > 0.005f) {
+
+      mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 315.0f - 90.0f * efficiency[n],
+                       315.0f, colors[n]);
+    }
+  }
+
+  return 0;
+}
+
+// Major faults, pages swapped in and pages swapped out per second as three
+// thin arcs between R3 and R4, growing from 45 degrees towards the TCP
+// gauge. They reach half way at 100 major faults and 100 pages a second, so
+// a system that has started to thrash fills its eighth of the ring.
+int HandleVM() {
+
+  if (vm <= 0) {
+
+    return 0;
+  }
+
+  static float paging[3] = {0.0f, 0.0f, 0.0f};
+
+  float in[3] = {sample->vm.majfaults / (100.0f + sample->vm.majfaults),
+                 sample->vm.swapin / (100.0f + sample->vm.swapin),
+                 sample->vm.swapout / (100.0f + sample->vm.swapout)};
+
+  const char *colors[] = {"rgba:ee/00/00/bb", "rgba:ff/a5/00/bb",
+                          "rgba:c0/60/ff/bb"};
+
+  float width = (R4 - R3) / 3.0f;
+
+  for (int n = 0; n < 3; n++) {
+
+    paging[n] = 0.5f * paging[n] + 0.5f * std::clamp(in[n], 0.0f, 1.0f);
+
+    float r1 = R3 + n * width, r2 = r1 + width;
+
+    if (paging[n] > 0.005f) {
+
+      mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 45.0f - 45.0f * paging[n], 45.0f,
+                       colors[n]);
+    }
+  }
+
+  return 0;
+}
+
+// TCP retransmits, listen drops and listen queue overflows per second as
+// three thin arcs between R3 and R4, growing from 315 degrees towards the
+// VM gauge. Retransmits reach half way at 10 a second and the listen
+// counters, which should stay at zero, at 1 a second.
+int HandleTCP() {
+
+  if (tcp <= 0) {
+
+    return 0;
+  }
+
+  static float losses[3] = {0.0f, 0.0f, 0.0f};
+
+  float in[3] = {
+      sample->tcp.retransmits / (10.0f + sample->tcp.retransmits),
+      sample->tcp.listendrops / (1.0f + sample->tcp.listendrops),
+      sample->tcp.listenoverflows / (1.0f + sample->tcp.listenoverflows)};
+
+  const char *colors[] = {"rgba:ff/a5/00/bb", "rgba:ee/00/00/bb",
+                          "rgba:c0/60/ff/bb"};
+
+  float width = (R4 - R3) / 3.0f;
+
+  for (int n = 0; n < 3; n++) {
+
+    losses[n] = 0.5f * losses[n] + 0.5f * std::clamp(in[n], 0.0f, 1.0f);
+
+    float r1 = R3 + n * width, r2 = r1 + width;
+
+    if (losses[n] > 0.005f) {
+
+      mwindow->DrawArc(CEN_X, CEN_Y, r1, r2, 315.0f, 315.0f + 45.0f * losses[n],
+                       colors[n]);
+    }
+  }
+
+  return 0;
+}
+
+// The frequency of each core as a tick in a ring of its own inside the
+// interrupt strip, in the same slots as the per-core ring, so a busy core
+// with a short tick is being held back. R4 is the edge of the window, so
+// the ring is the innermost of the four per-core rings inside R1; each is
+// CEN_X / 32 wide, which leaves the middle, out to 22 pixels in the
+// default window, to the user name and the process lines. The ticks turn
+// orange and then red as the hottest sensor nears its critical temperature.
+int HandleSensors() {
+
+  if (sensors <= 0 || sample->sensors.frequencies.empty()) {
+
+    return 0;
+  }
+
+  const char *color = sample->sensors.heat < 0.7f   ? "rgba:aa/aa/aa/bb"
+                      : sample->sensors.heat < 0.9f ? "rgba:ff/a5/00/bb"
+                                                    : "rgba:ee/00/00/bb";
+
+  mwindow->DrawSegments(CEN_X, CEN_Y, roundf(R1 - CEN_X * 4.0 / 32.0),
+                        roundf(R1 - CEN_X * 3.0 / 32.0),
+                        sample->sensors.frequencies, color);
+
+  return 0;
+}
+
+// The device interrupts and network softirqs of each core as a heat strip
+// inside the cgroup ring, in the same slots as the per-core ring. The
+// busiest core fills its slot, unless the whole machine handles fewer than
+// 1000 a second, so that a single core taking all of a NIC's interrupts
+// stands out.
+int HandleInterrupts() {
+
+  if (interrupts <= 0) {
+
+    return 0;
+  }
+
+  static std::vector<float> heat;
+
+  size_t ncores = std::max(sample->interrupts.hardirqs.size(),
+                           sample->interrupts.softirqs.size());
+
+  heat.assign(ncores, 0.0f);
+
+  for (size_t n = 0; n < ncores; n++) {
+
+    if (n < sample->interrupts.hardirqs.size()) {
+
+      heat[n] += sample->interrupts.hardirqs[n];
+    }
+
+    if (n < sample->interrupts.softirqs.size()) {
+
+      heat[n] += sample->interrupts.softirqs[n];
+    }
+  }
+
+  float busiest = 1000.0f;
+
+  for (float rate : heat) {
+
+    busiest = std::max(busiest, rate);
+  }
+
+  for (float &rate : heat) {
+
+    rate /= busiest;
+  }
+
+  mwindow->DrawSegments(CEN_X, CEN_Y, roundf(R1 - CEN_X * 3.0 / 32.0),
+                        roundf(R1 - CEN_X * 2.0 / 32.0), heat,
+                        "rgba:ff/2c/1c/bb");
+
+  return 0;
+}
+
+int HandleCgroups() {
+
+  if (cgroups <= 0 || sample->cgroups.empty()) {
+
+    return 0;
+  }
+
+  static std::vector<float> shares;
+
+  float ncores = std::max(static_cast<float>(sample->cores.size()), 1.0f);
+
+  shares.resize(sample->cgroups.size());
+
+  for (size_t n = 0; n < shares.size(); n++) {
+
+    shares[n] = std::clamp(sample->cgroups[n].cpu / ncores, 0.0f, 1.0f);
+  }
+
+  mwindow->DrawSegments(CEN_X, CEN_Y, roundf(R1 - CEN_X * 2.0 / 32.0),
+                        roundf(R1 - CEN_X * 1.0 / 32.0), shares,
+                        "rgba:00/c8/c8/bb");
+
+  const std::string &name = sample->cgroups.front().name;
+
+  mwindow->DrawText(CEN_X, CEN_Y - 40, name.substr(name.rfind('/') + 1),
+                    "rgba:00/c8/c8/bb", TEXT::ALIGN::CENTER);
+
+  return 0;
+}
+
+// The busiest processes, each with its share of one core, fill the space
+// between the user name and the number of users.
+int HandleProcesses() {
+
+  if (processes <= 0) {
+
+    return 0;
+  }
+
+  for (size_t n = 0; n < sample->processes.size() && n < 2; n++) {
+
+    std::string line =
+        sample->processes[n].name.substr(0, 8) + " " +
+        std::to_string(lroundf(100.0f * sample->processes[n].cpu)) + "%";
+
+    mwindow->DrawText(CEN_X, CEN_Y + 4 + 10 * n, line, "rgba:ff/8c/00/bb",
+                      TEXT::ALIGN::CENTER);
+  }
+
+  return 0;
+}
+
+int HandleStale() {
+
+  if (sample->stale) {
+
+    mwindow->DrawCircle(CEN_X, CEN_Y, R3, R4, "rgba:ff/00/00/66");
+  }
+
+  return 0;
+}
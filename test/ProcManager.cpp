@@ -0,0 +1,131 @@
+/**
+ *  @file   ProcManager.cpp
+ *  @brief  ProcManager Thread Sanitizer Stress Test
+ *  @author KrizTioaN (christiaanboersma@hotmail.com)
+ *  @date   2026-10-17
+ *  @note   BSD-3 licensed
+ *
+ ***********************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include <chrono>
+
+#include <string>
+
+#include "ProcManager.h"
+
+// Configures a ProcManager the way main() does, with every sensor on a
+// short interval, and takes snapshots as fast as a window never would
+// while the probe thread publishes. Built with -fsanitize=thread by "make
+// tsan", which fails on the first race. Managers that are destroyed right
+// away, before or after their first Probe(), cover start-up and shutdown.
+static const std::chrono::seconds DURATION(5);
+
+static void configure(ProcManager &manager, bool uring) {
+
+  manager.SetDisk("/");
+
+  manager.SetCPU("cpu");
+
+  manager.SetEth("auto");
+
+  manager.SetIO("*");
+
+  manager.SetCgroups(4);
+
+  manager.SetProcesses(4);
+
+  manager.SetUring(uring);
+
+  int mask = 0;
+
+  for (ProcManager::Masks sensor :
+       {ProcManager::Masks::CPU, ProcManager::Masks::Mem,
+        ProcManager::Masks::Disk, ProcManager::Masks::Eth,
+        ProcManager::Masks::IO, ProcManager::Masks::Users,
+        ProcManager::Masks::Battery, ProcManager::Masks::Pressure,
+        ProcManager::Masks::Cgroups, ProcManager::Masks::Processes,
+        ProcManager::Masks::Sensors, ProcManager::Masks::Interrupts,
+        ProcManager::Masks::Perf, ProcManager::Masks::VM,
+        ProcManager::Masks::TCP}) {
+
+    mask |= static_cast<int>(sensor);
+
+    manager.SetInterval(sensor, 5);
+  }
+
+  manager.SetProcMask(mask | ProcManager::Masks::Burst);
+
+  manager.SetInterval(ProcManager::Masks::Burst, 1);
+}
+
+int main(int argc, char *argv[]) {
+
+  bool uring = argc > 1 && strcmp(argv[1], "uring") == 0;
+
+  for (int n = 0; n < 8; n++) {
+
+    ProcManager manager;
+
+    configure(manager, uring);
+
+    if (n % 2 == 1) {
+
+      manager.Probe();
+    }
+  }
+
+  ProcManager manager;
+
+  configure(manager, uring);
+
+  manager.Probe();
+
+  std::chrono::steady_clock::time_point end =
+      std::chrono::steady_clock::now() + DURATION;
+
+  unsigned long snapshots = 0;
+
+  double checksum = 0.0;
+
+  while (std::chrono::steady_clock::now() < end) {
+
+    const ProcManager::s_sample &sample = manager.Snapshot();
+
+    checksum += sample.cpu.user + sample.memory.total + sample.eth.sent +
+                sample.io.read + sample.burst.received.max + sample.perf.ipc +
+                sample.vm.majfaults + sample.tcp.retransmits;
+
+    for (float core : sample.cores) {
+
+      checksum += core;
+    }
+
+    for (const DiskSampler::s_disk &disk : sample.disks) {
+
+      checksum += disk.blocks + disk.path.size();
+    }
+
+    for (const ProcessSampler::s_process &process : sample.processes) {
+
+      checksum += process.cpu + process.name.size();
+    }
+
+    for (const std::string &user : sample.users) {
+
+      checksum += user.size();
+    }
+
+    snapshots++;
+  }
+
+  const ProcManager::s_sample &sample = manager.Snapshot();
+
+  printf("ProcManager: %lu snapshots, %lu overruns, errors 0x%x%s\n",
+         snapshots, sample.overruns, sample.errors,
+         checksum >= 0.0 ? "" : " (negative)");
+
+  return 0;
+}